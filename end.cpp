@@ -8,6 +8,12 @@
 #include <algorithm>
 #include <climits>
 #include <bits/stdc++.h>
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -15,18 +21,38 @@ using namespace std;
 // Division Class
 // -----------------------------
 class Division {
+public:
+    // Games left between teams i < j; only pairs that still play are kept.
+    struct Fixture {
+        int teamI;
+        int teamJ;
+        uint16_t games;
+    };
+
+    struct Opponent {
+        int team;
+        uint16_t games;
+    };
+
+    static constexpr int maxGamesPerPair = numeric_limits<uint16_t>::max();
+
 private:
     int numTeams;
     vector<string> teamNames;
-    vector<int> wins;
-    vector<int> losses;
-    vector<int> remainingGames;
-    vector<vector<int>> remainingGamesMatrix;
+    vector<long long> wins;             // 64-bit so cumulative multi-season standings fit
+    vector<long long> losses;
+    vector<long long> remainingGames;
+    vector<Fixture> fixtures;           // in (teamI, teamJ) order
+    vector<vector<Opponent>> opponents; // every fixture, listed under both of its teams
 
     int stringToNumber(const string& s) const {
         return stoi(s);
     }
 
+    [[noreturn]] void throwAsymmetric(int i, int j) const {
+        throw runtime_error("Error: Games between " + teamNames[i] + " and " + teamNames[j] + " are not symmetric.");
+    }
+
 public:
     Division(const string& filename) {
         ifstream file(filename);
@@ -45,26 +71,43 @@ public:
             throw runtime_error("Error: At least two teams are required.");
         }
 
+        // Cells above the diagonal become fixtures as rows are read; the ones
+        // below are kept as (upper team, lower team, games) and must match them.
+        vector<Fixture> mirrored;
+
         // Read team data
         while (getline(file, line)) {
             if (line.empty()) continue; // Skip empty lines
             istringstream ss(line);
             string team;
-            int win, loss, remaining;
+            long long win, loss, remaining;
             ss >> team >> win >> loss >> remaining;
 
+            int row = teamNames.size();
             teamNames.push_back(team);
             wins.push_back(win);
             losses.push_back(loss);
             remainingGames.push_back(remaining);
 
-            vector<int> gamesAgainst;
             for (int i = 0; i < numTeams; ++i) {
-                int games;
-                ss >> games;
-                gamesAgainst.push_back(games);
+                long long games;
+                if (!(ss >> games)) {
+                    throw runtime_error("Error: Games of " + team + " against team " + to_string(i + 1) + " are missing or not a number.");
+                }
+                if (games < 0 || games > maxGamesPerPair) {
+                    throw runtime_error("Error: Games of " + team + " against team " + to_string(i + 1) + " must be between 0 and " +
+                                        to_string(maxGamesPerPair) + ".");
+                }
+                if (games == 0) continue;
+                if (i == row) {
+                    throw runtime_error("Error: Team " + team + " cannot have games against itself.");
+                }
+                if (i > row) {
+                    fixtures.push_back({row, i, static_cast<uint16_t>(games)});
+                } else {
+                    mirrored.push_back({i, row, static_cast<uint16_t>(games)});
+                }
             }
-            remainingGamesMatrix.push_back(gamesAgainst);
         }
 
         // Validate input
@@ -72,41 +115,327 @@ public:
             throw runtime_error("Error: Mismatch between number of teams and team data provided.");
         }
 
+        auto byPair = [](const Fixture& a, const Fixture& b) {
+            return make_pair(a.teamI, a.teamJ) < make_pair(b.teamI, b.teamJ);
+        };
+        sort(mirrored.begin(), mirrored.end(), byPair);
+        for (size_t k = 0; k < max(fixtures.size(), mirrored.size()); ++k) {
+            if (k == fixtures.size() || k == mirrored.size() || fixtures[k].teamI != mirrored[k].teamI ||
+                fixtures[k].teamJ != mirrored[k].teamJ || fixtures[k].games != mirrored[k].games) {
+                const Fixture& first = k == fixtures.size() || (k < mirrored.size() && byPair(mirrored[k], fixtures[k]))
+                                           ? mirrored[k] : fixtures[k];
+                throwAsymmetric(first.teamI, first.teamJ);
+            }
+        }
+
+        opponents.assign(numTeams, {});
+        for (const Fixture& fixture : fixtures) {
+            opponents[fixture.teamI].push_back({fixture.teamJ, fixture.games});
+            opponents[fixture.teamJ].push_back({fixture.teamI, fixture.games});
+        }
+
         file.close();
     }
 
     // Getter methods
     int getNumTeams() const { return numTeams; }
     const vector<string>& getTeamNames() const { return teamNames; }
-    const vector<int>& getWins() const { return wins; }
-    const vector<int>& getLosses() const { return losses; }
-    const vector<int>& getRemainingGames() const { return remainingGames; }
-    const vector<vector<int>>& getRemainingGamesMatrix() const { return remainingGamesMatrix; }
+    const vector<long long>& getWins() const { return wins; }
+    const vector<long long>& getLosses() const { return losses; }
+    const vector<long long>& getRemainingGames() const { return remainingGames; }
+    const vector<Fixture>& getFixtures() const { return fixtures; }
+    const vector<Opponent>& getOpponents(int team) const { return opponents[team]; }
+};
+
+// -----------------------------
+// Capacity Types
+// -----------------------------
+// The networks are instantiated for a capacity type picked per division.
+// uint16_t keeps the dense residual rows small on ordinary leagues, int32_t
+// covers the rest, and int64_t covers cumulative multi-season standings.
+// Game-to-team arcs get the type's largest value as infinity. That is safe
+// because a pair's forward and reverse residuals always sum to the arc's
+// capacity, and the chosen type holds every finite capacity below it.
+// Flow totals are summed in 64 bits whatever the capacity type.
+template <typename Cap>
+struct CapacityTraits {
+    static constexpr Cap infinity = numeric_limits<Cap>::max();
+};
+
+enum class CapacityType { UInt16, Int32, Int64 };
+
+// The largest finite capacity any team's network can have: a pair's remaining
+// games, or a ceiling minus the fewest wins in the division.
+long long largestCapacity(const Division& division) {
+    const auto& wins = division.getWins();
+    long long fewestWins = *min_element(wins.begin(), wins.end());
+    long long largest = 0;
+    for (int i = 0; i < division.getNumTeams(); ++i) {
+        largest = max(largest, wins[i] + division.getRemainingGames()[i] - fewestWins);
+    }
+    for (const Division::Fixture& fixture : division.getFixtures()) {
+        largest = max<long long>(largest, fixture.games);
+    }
+    return largest;
+}
+
+CapacityType chooseCapacityType(const Division& division) {
+    long long largest = largestCapacity(division);
+    if (largest < CapacityTraits<uint16_t>::infinity) return CapacityType::UInt16;
+    if (largest < CapacityTraits<int32_t>::infinity) return CapacityType::Int32;
+    return CapacityType::Int64;
+}
+
+const char* capacityTypeName(CapacityType type) {
+    switch (type) {
+        case CapacityType::UInt16: return "uint16";
+        case CapacityType::Int32: return "int32";
+        default: return "int64";
+    }
+}
+
+// -----------------------------
+// PrefixBound Class
+// -----------------------------
+// Necessary condition checked before building a network: the first k teams
+// by wins eliminate a team when their wins plus the games among them exceed
+// k times its ceiling. One sort prices every prefix, and a team may use the
+// best prefix shorter than its own position. A prefix of one team is the
+// trivial check.
+class PrefixBound {
+private:
+    vector<int> order;              // teams by wins, most first, ties by index
+    vector<int> position;
+    vector<long long> sortedWins;
+    vector<long long> total;        // total[k]: wins of the first k teams plus the games among them
+    vector<int> bestLength;         // bestLength[k]: the k' <= k with the largest total[k'] / k'
+    vector<int> lowestIndex;        // lowestIndex[k]: smallest team index among the first k
+
+public:
+    explicit PrefixBound(const Division& division) {
+        int numTeams = division.getNumTeams();
+        const vector<long long>& wins = division.getWins();
+
+        order.resize(numTeams);
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return wins[a] > wins[b]; });
+        position.resize(numTeams);
+        sortedWins.resize(numTeams);
+        for (int k = 0; k < numTeams; ++k) {
+            position[order[k]] = k;
+            sortedWins[k] = wins[order[k]];
+        }
+
+        total.assign(numTeams + 1, 0);
+        bestLength.assign(numTeams + 1, 0);
+        lowestIndex.assign(numTeams + 1, INT_MAX);
+        for (int k = 1; k <= numTeams; ++k) {
+            int team = order[k - 1];
+            total[k] = total[k - 1] + wins[team];
+            for (const Division::Opponent& opponent : division.getOpponents(team)) {
+                if (position[opponent.team] < k - 1) {
+                    total[k] += opponent.games;
+                }
+            }
+            // Cross-multiplied in 128 bits: totals of 64-bit wins times a length can pass 2^63
+            int best = bestLength[k - 1];
+            bestLength[k] = best == 0 || __int128(total[k]) * best > __int128(total[best]) * k ? k : best;
+            lowestIndex[k] = min(lowestIndex[k - 1], team);
+        }
+    }
+
+    // The lowest-numbered team that already has more wins than `ceiling`, or -1.
+    int trivialWitness(long long ceiling) const {
+        int above = partition_point(sortedWins.begin(), sortedWins.end(), [&](long long w) { return w > ceiling; })
+                    - sortedWins.begin();
+        return above > 0 ? lowestIndex[above] : -1;
+    }
+
+    // The teams of a prefix that eliminates `team` with the given ceiling, by index; empty if none.
+    vector<int> eliminatingSet(int team, long long ceiling) const {
+        int length = bestLength[position[team]];
+        vector<int> teams;
+        if (length > 0 && total[length] > __int128(ceiling) * length) {
+            teams.assign(order.begin(), order.begin() + length);
+            sort(teams.begin(), teams.end());
+        }
+        return teams;
+    }
 };
 
 // -----------------------------
 // Graph Class
 // -----------------------------
+template <typename Cap>
 class Graph {
 private:
     int numVertices;
-    vector<vector<int>> adjList; // adjacency list with capacities
+    vector<vector<Cap>> adjList; // adjacency list with capacities
 
 public:
-    // Graph(int vertices) : numVertices(vertices), adjList(vertices, vector<int>(vertices, 0)) {}
+    // Graph(int vertices) : numVertices(vertices), adjList(vertices, vector<Cap>(vertices, 0)) {}
         Graph(int vertices) {
         numVertices = vertices;
-        adjList = vector<vector<int>>(vertices, vector<int>(vertices, 0));
+        adjList = vector<vector<Cap>>(vertices, vector<Cap>(vertices, 0));
     }
 
-    void addEdge(int from, int to, int capacity) {
+    void addEdge(int from, int to, Cap capacity) {
         adjList[from][to] = capacity;
     }
 
-    const vector<vector<int>>& getAdjList() const { return adjList; }
+    const vector<vector<Cap>>& getAdjList() const { return adjList; }
     int getNumVertices() const { return numVertices; }
 };
 
+// -----------------------------
+// Row Scan Kernels
+// -----------------------------
+// The dense BFS asks one question per dequeued vertex: which entries of its
+// residual row are positive? A kernel answers it for up to 64 consecutive
+// columns as a bitmask, which the BFS then ANDs with the unvisited set. The
+// AVX2 and SSE2 kernels compare a register of lanes at once (16 or 8 for
+// uint16_t, 8 or 4 for int32_t, 4 or 2 for int64_t); the scalar kernel is
+// the fallback and the reference. Residuals are never negative, so the
+// uint16_t and int64_t kernels test for nonzero lanes, which SSE2 and AVX2
+// can compare directly. The best kernel the CPU supports is picked at
+// runtime, so the binary needs no -mavx2.
+template <typename Cap>
+using RowScanKernel = uint64_t (*)(const Cap* row, int count);
+
+template <typename Cap>
+uint64_t scanRowScalar(const Cap* row, int count) {
+    uint64_t mask = 0;
+    for (int i = 0; i < count; ++i) {
+        if (row[i] > 0) {
+            mask |= uint64_t(1) << i;
+        }
+    }
+    return mask;
+}
+
+// Mask bits for the columns [i, count) a vector loop left over, shifted into
+// place. A full 64-column chunk leaves none, and shifting by 64 is undefined.
+template <typename Cap>
+uint64_t scanRowTail(const Cap* row, int i, int count) {
+    return i < count ? scanRowScalar(row + i, count - i) << i : 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+uint64_t scanRowSSE2(const uint16_t* row, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i isZero = _mm_packs_epi16(_mm_cmpeq_epi16(lanes, zero), zero);
+        uint64_t positive = ~_mm_movemask_epi8(isZero) & 0xFF;
+        mask |= positive << i;
+    }
+    return mask | scanRowTail(row, i, count);
+}
+
+__attribute__((target("sse2")))
+uint64_t scanRowSSE2(const int32_t* row, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        uint64_t positive = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(lanes, zero)));
+        mask |= positive << i;
+    }
+    return mask | scanRowTail(row, i, count);
+}
+
+// SSE2 has no 64-bit compare: a lane is zero when both of its halves are.
+__attribute__((target("sse2")))
+uint64_t scanRowSSE2(const int64_t* row, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i halves = _mm_cmpeq_epi32(lanes, zero);
+        __m128i isZero = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+        uint64_t positive = ~_mm_movemask_pd(_mm_castsi128_pd(isZero)) & 0x3;
+        mask |= positive << i;
+    }
+    return mask | scanRowTail(row, i, count);
+}
+
+// The pack works within each 128-bit half, so lanes 8-15 land in mask bits 16-23.
+__attribute__((target("avx2")))
+uint64_t scanRowAVX2(const uint16_t* row, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        __m256i isZero = _mm256_packs_epi16(_mm256_cmpeq_epi16(lanes, zero), zero);
+        uint32_t bits = _mm256_movemask_epi8(isZero);
+        uint64_t positive = ~((bits & 0xFF) | ((bits >> 8) & 0xFF00)) & 0xFFFF;
+        mask |= positive << i;
+    }
+    return mask | scanRowTail(row, i, count);
+}
+
+__attribute__((target("avx2")))
+uint64_t scanRowAVX2(const int32_t* row, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        uint64_t positive = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(lanes, zero)));
+        mask |= positive << i;
+    }
+    return mask | scanRowTail(row, i, count);
+}
+
+__attribute__((target("avx2")))
+uint64_t scanRowAVX2(const int64_t* row, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    uint64_t mask = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        uint64_t positive = ~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lanes, zero))) & 0xF;
+        mask |= positive << i;
+    }
+    return mask | scanRowTail(row, i, count);
+}
+#endif
+
+template <typename Cap>
+struct NamedRowScanKernel {
+    const char* name;
+    RowScanKernel<Cap> scan;
+};
+
+// Kernels this CPU can run for Cap, best first; scalar is always last.
+template <typename Cap>
+vector<NamedRowScanKernel<Cap>> supportedRowScanKernels() {
+    vector<NamedRowScanKernel<Cap>> kernels;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back({"avx2", static_cast<RowScanKernel<Cap>>(scanRowAVX2)});
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        kernels.push_back({"sse2", static_cast<RowScanKernel<Cap>>(scanRowSSE2)});
+    }
+#endif
+    kernels.push_back({"scalar", scanRowScalar<Cap>});
+    return kernels;
+}
+
+template <typename Cap>
+RowScanKernel<Cap> bestRowScanKernel() {
+    static const RowScanKernel<Cap> best = supportedRowScanKernels<Cap>().front().scan;
+    return best;
+}
+
 // -----------------------------
 // Ford-Fulkerson Class
 // -----------------------------
@@ -174,17 +503,30 @@ public:
 //         return maxFlow;
 //     }
 // };
+template <typename Cap>
 class FordFulkerson {
 private:
-    const Graph& graph;
+    const Graph<Cap>& graph;
     int source;
     int sink;
     vector<int> parent;
-    vector<vector<int>> residual;
+    vector<vector<Cap>> residual;
+    RowScanKernel<Cap> scanRow;
+    vector<uint64_t> unvisited;     // one bit per vertex not yet reached by the current BFS
 
+    // Visits rows 64 columns at a time: the kernel's positive-entry mask,
+    // ANDed with the unvisited bits, is the batch of new frontier vertices.
+    // They are taken in column order, so the paths match a one-by-one scan.
     bool bfs() {
-        parent.assign(graph.getNumVertices(), -1);
+        int n = graph.getNumVertices();
+        int numWords = (n + 63) / 64;
+        parent.assign(n, -1);
         parent[source] = -2;
+        unvisited.assign(numWords, ~uint64_t(0));
+        if (n % 64 != 0) {
+            unvisited.back() = (uint64_t(1) << (n % 64)) - 1;
+        }
+        unvisited[source / 64] &= ~(uint64_t(1) << (source % 64));
         queue<int> q;
         q.push(source);
 
@@ -192,8 +534,15 @@ private:
             int current = q.front();
             q.pop();
 
-            for (int next = 0; next < graph.getNumVertices(); ++next) {
-                if (parent[next] == -1 && residual[current][next] > 0) {
+            const Cap* row = residual[current].data();
+            for (int w = 0; w < numWords; ++w) {
+                if (unvisited[w] == 0) continue;
+                int base = w * 64;
+                uint64_t reached = scanRow(row + base, min(64, n - base)) & unvisited[w];
+                unvisited[w] &= ~reached;
+                while (reached) {
+                    int next = base + __builtin_ctzll(reached);
+                    reached &= reached - 1;
                     parent[next] = current;
                     if (next == sink) {
                         return true;
@@ -206,15 +555,15 @@ private:
     }
 
 public:
-    FordFulkerson(const Graph& g, int s, int t)
-        : graph(g), source(s), sink(t), parent(g.getNumVertices(), -1), residual(g.getAdjList()) {}
+    FordFulkerson(const Graph<Cap>& g, int s, int t, RowScanKernel<Cap> kernel = bestRowScanKernel<Cap>())
+        : graph(g), source(s), sink(t), parent(g.getNumVertices(), -1), residual(g.getAdjList()), scanRow(kernel) {}
 
-    int getMaxFlow() {
-        int maxFlow = 0;
+    long long getMaxFlow() {
+        long long maxFlow = 0;
 
         while (bfs()) {
             // Find bottleneck capacity
-            int pathFlow = INT_MAX;
+            Cap pathFlow = CapacityTraits<Cap>::infinity;
             for (int v = sink; v != source; v = parent[v]) { 
                 // we move from sink to source (because of parent vector we maintain)
                 int u = parent[v];
@@ -234,7 +583,7 @@ public:
         return maxFlow;
     }
 
-    const vector<vector<int>>& getResidualGraph() const {
+    const vector<vector<Cap>>& getResidualGraph() const {
         return residual;
     }
 };
@@ -243,9 +592,10 @@ public:
 // -----------------------------
 // FlowNetwork Class
 // -----------------------------
+template <typename Cap>
 class FlowNetwork {
 private:
-    Graph graph;
+    Graph<Cap> graph;
     int source;
     int sink;
     int leftTeam;
@@ -256,21 +606,12 @@ public:
         : graph(0), source(0), sink(0), leftTeam(teamIndex), teamNames(division.getTeamNames()) {
         int numTeams = division.getNumTeams();
         // Calculate number of game nodes
-        int numGames = 0;
-        for (int i = 0; i < numTeams; ++i) {
-            for (int j = i + 1; j < numTeams; ++j) {
-                if (i != teamIndex && j != teamIndex) {
-                    int gamesLeft = division.getRemainingGamesMatrix()[i][j];
-                    if (gamesLeft > 0) {
-                        numGames++;
-                    }
-                }
-            }
-        }
+        const auto& fixtures = division.getFixtures();
+        int numGames = fixtures.size() - division.getOpponents(teamIndex).size();
 
         // Total nodes = source + game nodes + team nodes + sink
         int totalNodes = 2 + numGames + (numTeams - 1);
-        graph = Graph(totalNodes);
+        graph = Graph<Cap>(totalNodes);
         source = 0;
         sink = totalNodes - 1;
 
@@ -279,32 +620,27 @@ public:
 
         // Add edges from source to game nodes
         int gameNode = gameNodeStart;
-        const auto& remainingGames = division.getRemainingGamesMatrix();
-        for (int i = 0; i < numTeams; ++i) {
-            if (i == teamIndex) continue;
-            for (int j = i + 1; j < numTeams; ++j) {
-                if (j == teamIndex) continue;
-                int gamesLeft = remainingGames[i][j];
-                if (gamesLeft > 0) {
-                    graph.addEdge(source, gameNode, gamesLeft);
-                    // Connect game node to team nodes
-                    // Adjust team node index based on whether team index is greater than teamIndex
-                    int teamNodeI = teamNodeStart + i - (i > teamIndex ? 1 : 0);
-                    int teamNodeJ = teamNodeStart + j - (j > teamIndex ? 1 : 0);
-                    graph.addEdge(gameNode, teamNodeI, INT32_MAX);
-                    graph.addEdge(gameNode, teamNodeJ, INT32_MAX);
-                    gameNode++;
-                }
-            }
+        for (const Division::Fixture& fixture : fixtures) {
+            int i = fixture.teamI;
+            int j = fixture.teamJ;
+            if (i == teamIndex || j == teamIndex) continue;
+            graph.addEdge(source, gameNode, fixture.games);
+            // Connect game node to team nodes
+            // Adjust team node index based on whether team index is greater than teamIndex
+            int teamNodeI = teamNodeStart + i - (i > teamIndex ? 1 : 0);
+            int teamNodeJ = teamNodeStart + j - (j > teamIndex ? 1 : 0);
+            graph.addEdge(gameNode, teamNodeI, CapacityTraits<Cap>::infinity);
+            graph.addEdge(gameNode, teamNodeJ, CapacityTraits<Cap>::infinity);
+            gameNode++;
         }
 
         // Calculate the maximum number of games Team X can win
-        int maxPossibleWins = division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex];
+        long long maxPossibleWins = division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex];
 
         // Add edges from team nodes to sink
         for (int i = 0; i < numTeams; ++i) {
             if (i == teamIndex) continue;
-            int capacity = maxPossibleWins - division.getWins()[i];
+            long long capacity = maxPossibleWins - division.getWins()[i];
             if (capacity < 0) {
                 capacity = 0; // Team already has more wins than Team X can achieve
             }
@@ -329,49 +665,55 @@ public:
     //     cout<<totalGames<<endl;
     //     return maxFlow < totalGames;
     // }
-    bool isEliminated() const {
+    // Max flow without the diagnostic dump, for timing the BFS kernels.
+    long long getMaxFlow(RowScanKernel<Cap> kernel) const {
+        FordFulkerson<Cap> ff(graph, source, sink, kernel);
+        return ff.getMaxFlow();
+    }
+
+    bool isEliminated(ostream& out) const {
     // Print adjacency list before max-flow computation
-    cout << "Adjacency List (Original Capacities):" << endl;
+    out << "Adjacency List (Original Capacities):" << endl;
     const auto& adjList = graph.getAdjList();
     for (size_t i = 0; i < adjList.size(); ++i) {
         for (size_t j = 0; j < adjList[i].size(); ++j) {
             if (adjList[i][j] > 0) {
-                cout << "Edge from " << i << " to " << j << " with capacity " << adjList[i][j] << endl;
+                out << "Edge from " << i << " to " << j << " with capacity " << adjList[i][j] << endl;
             }
         }
     }
 
     // Run Ford-Fulkerson algorithm
-    FordFulkerson ff(graph, source, sink);
-    int maxFlow = ff.getMaxFlow();
-    cout << "MAX FLOW" << endl;
-    cout << maxFlow << endl;
+    FordFulkerson<Cap> ff(graph, source, sink);
+    long long maxFlow = ff.getMaxFlow();
+    out << "MAX FLOW" << endl;
+    out << maxFlow << endl;
 
     // Calculate total remaining games (from source)
-    int totalGames = 0;
+    long long totalGames = 0;
     for (size_t j = 0; j < adjList[source].size(); ++j) {
         totalGames += adjList[source][j];
     }
-    cout << "Total remaining games: " << totalGames << endl;
+    out << "Total remaining games: " << totalGames << endl;
 
     // Print residual capacities after max-flow computation
-    cout << "Residual Capacities After Max Flow:" << endl;
+    out << "Residual Capacities After Max Flow:" << endl;
     const auto& residual = ff.getResidualGraph();
     for (size_t i = 0; i < residual.size(); ++i) {
         for (size_t j = 0; j < residual[i].size(); ++j) {
             if (adjList[i][j] > 0) { // Only print edges that existed in the original graph
-                cout << "Edge from " << i << " to " << j << " has residual capacity " << residual[i][j] << endl;
+                out << "Edge from " << i << " to " << j << " has residual capacity " << residual[i][j] << endl;
             }
         }
     }
 
     // Optionally, print the flow along each edge
-    cout << "Flow Along Each Edge:" << endl;
+    out << "Flow Along Each Edge:" << endl;
     for (size_t i = 0; i < residual.size(); ++i) {
         for (size_t j = 0; j < residual[i].size(); ++j) {
-            int flow = adjList[i][j] - residual[i][j];
+            long long flow = static_cast<long long>(adjList[i][j]) - residual[i][j];
             if (flow > 0) {
-                cout << "Edge from " << i << " to " << j << " carries flow " << flow << endl;
+                out << "Edge from " << i << " to " << j << " carries flow " << flow << endl;
             }
         }
     }
@@ -381,10 +723,163 @@ public:
 
 };
 
+// -----------------------------
+// BFS Kernel Benchmark
+// -----------------------------
+// Times every team's max flow with each supported row-scan kernel and checks
+// that all kernels find the same flows.
+template <typename Cap>
+void runBfsBenchmark(const Division& division, int repeats) {
+    vector<FlowNetwork<Cap>> networks;
+    for (int teamIndex = 0; teamIndex < division.getNumTeams(); ++teamIndex) {
+        networks.emplace_back(division, teamIndex);
+    }
+
+    double scalarMs = 0;
+    long long referenceFlow = -1;
+    vector<NamedRowScanKernel<Cap>> kernels = supportedRowScanKernels<Cap>();
+    reverse(kernels.begin(), kernels.end());    // scalar first, as the baseline
+    cout << setw(8) << "kernel" << setw(12) << "total_ms" << setw(10) << "speedup" << setw(12) << "flow_sum" << "\n";
+    for (const auto& kernel : kernels) {
+        long long flowSum = 0;
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            for (const auto& network : networks) {
+                flowSum += network.getMaxFlow(kernel.scan);
+            }
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (referenceFlow < 0) {
+            referenceFlow = flowSum;
+            scalarMs = ms;
+        } else if (flowSum != referenceFlow) {
+            throw runtime_error(string("Error: Kernel ") + kernel.name + " disagrees with the scalar max flows.");
+        }
+        cout << setw(8) << kernel.name << setw(12) << fixed << setprecision(2) << ms
+             << setw(10) << (ms > 0 ? scalarMs / ms : 0) << setw(12) << flowSum << "\n";
+    }
+}
+
+void runBfsBenchmark(const string& filename, int repeats) {
+    Division division(filename);
+    CapacityType type = chooseCapacityType(division);
+    cout << "capacity type: " << capacityTypeName(type) << "\n";
+    switch (type) {
+        case CapacityType::UInt16: runBfsBenchmark<uint16_t>(division, repeats); break;
+        case CapacityType::Int32: runBfsBenchmark<int32_t>(division, repeats); break;
+        case CapacityType::Int64: runBfsBenchmark<int64_t>(division, repeats); break;
+    }
+}
+
+// Builds the team's network with the division's capacity type and writes the
+// diagnostic check to `out`.
+bool isEliminated(const Division& division, int teamIndex, CapacityType type, ostream& out) {
+    switch (type) {
+        case CapacityType::UInt16: return FlowNetwork<uint16_t>(division, teamIndex).isEliminated(out);
+        case CapacityType::Int32: return FlowNetwork<int32_t>(division, teamIndex).isEliminated(out);
+        default: return FlowNetwork<int64_t>(division, teamIndex).isEliminated(out);
+    }
+}
+
+// Writes one team's full report, diagnostics included, to `out`.
+void writeTeamReport(const Division& division, const PrefixBound& bound, CapacityType capacityType, int teamIndex,
+                     ostream& out) {
+    // Trivial elimination check
+    long long maxPossibleWins = division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex];
+    int witness = bound.trivialWitness(maxPossibleWins);
+    vector<int> prefix = witness < 0 ? bound.eliminatingSet(teamIndex, maxPossibleWins) : vector<int>();
+
+    if (witness >= 0) {
+        out << division.getTeamNames()[teamIndex] << " is trivially eliminated.\n";
+        out << division.getTeamNames()[witness] << " already has more wins than Team " << division.getTeamNames()[teamIndex] << " can achieve.\n\n";
+    } else if (!prefix.empty()) {
+        out << division.getTeamNames()[teamIndex] << " is eliminated.\n";
+        out << "They are eliminated by the subset { ";
+        for (int team : prefix) {
+            out << division.getTeamNames()[team] << " ";
+        }
+        out << "}.\n\n";
+    } else {
+        // Non-trivial elimination check using Flow Network
+        if (isEliminated(division, teamIndex, capacityType, out)) {
+            out << division.getTeamNames()[teamIndex] << " is eliminated.\n";
+            // Additional details can be implemented here (e.g., identifying the certificate of elimination)
+        } else {
+            out << division.getTeamNames()[teamIndex] << " is not eliminated.\n";
+        }
+        out << "\n";
+    }
+}
+
+// Each team's network is independent, so worker threads claim team indices
+// from a shared counter. Reports are buffered per team and printed in team
+// order, so the output matches a serial run.
+void analyzeDivision(const Division& division, int threads) {
+    int numTeams = division.getNumTeams();
+    PrefixBound bound(division);
+    CapacityType capacityType = chooseCapacityType(division);
+
+    vector<string> reports(numTeams);
+    atomic<int> next(0);
+    auto worker = [&]() {
+        for (int teamIndex = next++; teamIndex < numTeams; teamIndex = next++) {
+            ostringstream out;
+            writeTeamReport(division, bound, capacityType, teamIndex, out);
+            reports[teamIndex] = out.str();
+        }
+    };
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    for (const string& report : reports) {
+        cout << report;
+    }
+}
+
 // -----------------------------
 // Main Function
 // -----------------------------
-int main() {
+// Usage: end [--threads N]             (prompts for the standings file)
+//        end --bench-bfs file [repeats]
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && string(argv[1]) == "--bench-bfs") {
+        try {
+            runBfsBenchmark(argv[2], argc >= 4 ? max(1, stoi(argv[3])) : 1);
+        } catch (const exception& e) {
+            cerr << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    int threads = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            try {
+                threads = stoi(argv[++i]);
+            } catch (const exception&) {
+                threads = -1;
+            }
+            if (threads < 0) {
+                cerr << "Error: --threads expects a non-negative number.\n";
+                return 1;
+            }
+            if (threads == 0) {
+                threads = max(1u, thread::hardware_concurrency());
+            }
+        } else {
+            cerr << "Error: Unknown argument '" << arg << "'.\n";
+            return 1;
+        }
+    }
+
     string filename;
     cout << "Enter File Name:\n";
     cin >> filename;
@@ -392,38 +887,7 @@ int main() {
 
     try {
         Division division(filename);
-        int numTeams = division.getNumTeams();
-
-        for (int teamIndex = 0; teamIndex < numTeams; ++teamIndex) {
-            // Trivial elimination check
-            int maxPossibleWins = division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex];
-            bool triviallyEliminated = false;
-            string eliminationReason = "";
-
-            for (int i = 0; i < numTeams; ++i) {
-                if (i == teamIndex) continue;
-                if (division.getWins()[i] > maxPossibleWins) {
-                    triviallyEliminated = true;
-                    eliminationReason = division.getTeamNames()[i] + " already has more wins than Team " + division.getTeamNames()[teamIndex] + " can achieve.";
-                    break;
-                }
-            }
-
-            if (triviallyEliminated) {
-                cout << division.getTeamNames()[teamIndex] << " is trivially eliminated.\n";
-                cout << eliminationReason << "\n\n";
-            } else {
-                // Non-trivial elimination check using Flow Network
-                FlowNetwork fn(division, teamIndex);
-                if (fn.isEliminated()) {
-                    cout << division.getTeamNames()[teamIndex] << " is eliminated.\n";
-                    // Additional details can be implemented here (e.g., identifying the certificate of elimination)
-                } else {
-                    cout << division.getTeamNames()[teamIndex] << " is not eliminated.\n";
-                }
-                cout << "\n";
-            }
-        }
+        analyzeDivision(division, threads);
     } catch (const exception& e) {
         cerr << e.what() << "\n";
         return 1;
@@ -7,9 +7,10 @@
 #include <stack>
 #include <queue>
 #include <algorithm>
+#include <thread>
+#include <atomic>
 #include <bits/stdc++.h>
 using namespace std;
-int counter = 0;
 
 vector<string> txtToString(string filename)
 {
@@ -53,7 +54,28 @@ private:
 	int n;
 	vector<string> teamNames;
 	vector<int> wins, loss, left;
-	vector<vector<int>> games;
+	vector<unsigned short> games; // upper triangle (i < j), row by row
+
+	int pairIndex(int i, int j)
+	{
+		return i * this->n - i * (i + 1) / 2 + (j - i - 1);
+	}
+
+	// Games team i has left against team number `column`; the token must be a
+	// plain number that fits the 16-bit cell.
+	int gamesCell(const string &word, int i, int column)
+	{
+		long long count = 0;
+		for (char c : word)
+		{
+			if (c < '0' || c > '9')
+				throw "games of " + this->teamNames[i] + " against team " + to_string(column + 1) + " are not a number: '" + word + "'";
+			count = min(10 * count + (c - '0'), (long long)USHRT_MAX + 1);
+		}
+		if (count > USHRT_MAX)
+			throw this->teamNames[i] + " has more than " + to_string(USHRT_MAX) + " games left against team " + to_string(column + 1);
+		return (int)count;
+	}
 
 public:
 	divison(vector<string> v)
@@ -61,11 +83,10 @@ public:
 		int n = stringToNumber(v[0]);
 		v.erase(v.begin());
 		this->n = n;
+		this->games.assign(n * (n - 1) / 2, 0);
 		for (int i = 0; i < n; i++)
 		{
 			int j = 0;
-			vector<int> temp;
-			this->games.push_back(temp);
 			istringstream s(v[i]);
 			do
 			{
@@ -86,7 +107,14 @@ public:
 					this->left.push_back(stringToNumber(word));
 					break;
 				default:
-					this->games[i].push_back(stringToNumber(word));
+					// Rows are read in order, so a lower-triangle cell is checked
+					// against the upper-triangle cell its row stored earlier
+					if (word.empty() || j - 4 >= n)
+						break;
+					if (j - 4 > i)
+						this->games[pairIndex(i, j - 4)] = gamesCell(word, i, j - 4);
+					else if (j - 4 < i && this->games[pairIndex(j - 4, i)] != gamesCell(word, i, j - 4))
+						throw "games between " + this->teamNames[j - 4] + " and " + this->teamNames[i] + " are not symmetric";
 					break;
 				}
 				j++;
@@ -119,60 +147,73 @@ public:
 		return this->left;
 	}
 
-	vector<vector<int>> getGames()
+	int getGames(int i, int j)
 	{
-		return this->games;
+		if (i == j)
+			return 0;
+		if (i > j)
+			swap(i, j);
+		return this->games[pairIndex(i, j)];
 	}
 };
 
+// Compile-time infinity for a capacity type. A game-to-team arc's forward and
+// reverse residuals always sum to its capacity, so augmenting never pushes
+// either past infinity; flow totals are summed in long long.
+template <typename T>
+struct capacityTraits
+{
+	static constexpr T infinity = numeric_limits<T>::max();
+};
+
 class flowNetwork
 {
 private:
 	int n, leftTeam, ngames, nteams;
-	vector<string> nodes, teamNames;
+	vector<int> nodeTeam; // team index of each team node, -1 for the other nodes
+	vector<string> teamNames;
 	vector<vector<int>> cap, edges;
 	vector<vector<bool>> adjMat;
 
 public:
 	flowNetwork(divison d, int curTeam)
 	{
-		int numTeams = d.getNTeams() - 1, numGames = (d.getNTeams() - 1) * (d.getNTeams() - 2) / 2;
+		// only pairs with games left get a game node
+		int numTeams = d.getNTeams() - 1, numGames = 0;
+		for (int i = 0; i < d.getNTeams(); i++)
+			for (int j = i + 1; j < d.getNTeams(); j++)
+				if (i != curTeam && j != curTeam && d.getGames(i, j) > 0)
+					numGames++;
 		int totalNodes = numTeams + numGames + 2;
 		vector<vector<int>> fn(totalNodes, vector<int>(totalNodes, 0));
 		vector<vector<int>> e(totalNodes);
 		vector<vector<bool>> am(totalNodes, vector<bool>(totalNodes, false));
-		vector<string> nod(totalNodes, "");
-		nod[0] = "s";
-		nod[totalNodes - 1] = "t";
+		vector<int> nod(totalNodes, -1);
 		int k = 1, skip = 0;
 		for (int i = 0; i < d.getNTeams(); i++)
 		{
-			vector<int> temp = d.getGames()[i];
 			if (i == curTeam)
 				continue;
 			for (int j = i + 1; j < d.getNTeams(); j++)
 			{
-				if (j == curTeam)
+				if (j == curTeam || d.getGames(i, j) == 0)
 					continue;
-				fn[0][k] = temp[j];
+				fn[0][k] = d.getGames(i, j);
 				am[0][k] = true;
 				e[0].push_back(k);
-				nod[k] = to_string(i) + "-" + to_string(j);
 				fn[k][0] = 0;
 				if (i > curTeam)
 					skip = 1;
 				else
 					skip = 0;
-				fn[k][numGames + i + 1 - skip] = INT_MAX;
-				nod[numGames + i + 1 - skip] = d.getTeamNames()[i];
+				fn[k][numGames + i + 1 - skip] = capacityTraits<int>::infinity;
 				am[k][numGames + i + 1 - skip] = true;
 				e[k].push_back(numGames + i + 1 - skip);
 				if (j > curTeam)
 					skip = 1;
 				else
 					skip = 0;
-				fn[k][numGames + j + 1 - skip] = INT_MAX;
-				nod[numGames + j + 1 - skip] = d.getTeamNames()[j];
+				fn[k][numGames + j + 1 - skip] = capacityTraits<int>::infinity;
 				am[k][numGames + j + 1 - skip] = true;
 				e[k].push_back(numGames + j + 1 - skip);
 				if (i > curTeam)
@@ -192,6 +233,7 @@ public:
 			else
 				skip = 0;
 			// cout << teamNames[i] << " " << endl;
+			nod[numGames + i + 1 - skip] = i;
 			fn[numGames + i + 1 - skip][totalNodes - 1] = d.getWins()[curTeam] + d.getLeft()[curTeam] - d.getWins()[i];
 			am[numGames + i + 1 - skip][totalNodes - 1] = true;
 			e[numGames + i + 1 - skip].push_back(totalNodes - 1);
@@ -199,7 +241,7 @@ public:
 		this->n = totalNodes;
 		this->ngames = numGames;
 		this->nteams = numTeams;
-		this->nodes = nod;
+		this->nodeTeam = nod;
 		this->teamNames = d.getTeamNames();
 		this->cap = fn;
 		this->adjMat = am;
@@ -233,11 +275,12 @@ public:
 		return path;
 	}
 
-	void maxFlowFordFulkerson(divison d)
+	// Writes the verdict for leftTeam to out; returns true when the team is not eliminated.
+	bool maxFlowFordFulkerson(divison d, ostream &out)
 	{
 		vector<int> path;
 		vector<vector<int>> resNet(this->n, vector<int>(this->n, 0)); // res Ntwork
-		int maxFlow = 0, saturation = 0;
+		long long maxFlow = 0, saturation = 0;
 		resNet = this->cap;
 		// if (this->teamNames[leftTeam] == "Detroit")
 		// {
@@ -262,7 +305,7 @@ public:
 		path = this->bfs(resNet);
 		while (path[this->n - 1] != INT_MIN)
 		{
-			int bottleneck = INT_MAX;
+			int bottleneck = capacityTraits<int>::infinity;
 			for (int i = this->n - 1; i > 0; i = path[i])
 				bottleneck = bottleneck < resNet[path[i]][i] ? bottleneck : resNet[path[i]][i];
 			for (int i = this->n - 1; i > 0; i = path[i])
@@ -284,14 +327,7 @@ public:
 		// cout << this->teamNames[leftTeam] << endl;
 		// cout << saturation << " " << maxFlow << endl;
 		if (saturation == maxFlow)
-		{
-			counter++;
-			if (counter == d.getNTeams())
-			{
-				cout << "No team is eliminated." << endl;
-			}
-			return;
-		}
+			return true;
 		else
 		{
 			vector<bool> visited(this->n, false);
@@ -310,62 +346,188 @@ public:
 				}
 			}
 			// cout << "hi" << endl;
-			cout << this->teamNames[leftTeam] << " is eliminated.\nThey can win at most " << d.getWins()[leftTeam] << " + " << d.getLeft()[leftTeam] << " = " << d.getWins()[leftTeam] + d.getLeft()[leftTeam] << " games.\n";
+			out << this->teamNames[leftTeam] << " is eliminated.\nThey can win at most " << d.getWins()[leftTeam] << " + " << d.getLeft()[leftTeam] << " = " << d.getWins()[leftTeam] + d.getLeft()[leftTeam] << " games.\n";
 			vector<int> positions;
 			vector<string> tn = d.getTeamNames();
 			int wins = 0, remain = 0;
 			for (int i = this->ngames + 1; i < this->n - 1; i++)
 				if (visited[i] && !visited[this->n - 1] && this->adjMat[i][this->n - 1])
-					positions.push_back(find(tn.begin(), tn.end(), this->nodes[i]) - tn.begin());
-			cout << tn[positions[0]];
+					positions.push_back(this->nodeTeam[i]);
+			out << tn[positions[0]];
 			for (int i = 0; i < positions.size(); i++)
 			{
 				wins += d.getWins()[positions[i]];
 				if (i != 0 && i != positions.size() - 1)
-					cout << ", " << tn[positions[i]];
+					out << ", " << tn[positions[i]];
 				else if (i != 0)
-					cout << " and " << tn[positions[i]];
+					out << " and " << tn[positions[i]];
 			}
 			sort(positions.begin(), positions.end());
 			for (int i = 0; i < positions.size() - 1; i++)
 			{
 				for (int j = i + 1; j < positions.size(); j++)
-					remain += d.getGames()[positions[i]][positions[j]];
+					remain += d.getGames(positions[i], positions[j]);
 			}
-			cout << " have won a total of " << wins << " games.\nThey play each other " << remain << " times.\nSo on average, each of the team wins " << wins + remain << "/" << positions.size() << " = " << float(wins + remain) / float(positions.size()) << " games.\n\n";
+			out << " have won a total of " << wins << " games.\nThey play each other " << remain << " times.\nSo on average, each of the team wins " << wins + remain << "/" << positions.size() << " = " << float(wins + remain) / float(positions.size()) << " games.\n\n";
+			return false;
 		}
 	}
 };
-int ix = 0;
-void eliminate(divison d, int n, int max, int min)
+// Cheap necessary condition checked before any flow network is built. The
+// first k teams by wins eliminate team i when their wins plus the games
+// among them exceed k times i's ceiling. Sorting once and accumulating along
+// that order prices every prefix; team i may use the best prefix of length
+// k <= its own position, since those do not contain it.
+class prefixBound
 {
-	vector<int> positions;
-	for (int i = 0; i < n; i++)
+private:
+	vector<int> order, position, best;
+	vector<long long> total;
+
+public:
+	prefixBound(divison d)
 	{
-		cout << "I" << i << endl;
-		if (d.getWins()[i] + d.getLeft()[i] < d.getWins()[max])
+		int n = d.getNTeams();
+		vector<int> wins = d.getWins();
+		order.resize(n);
+		position.resize(n);
+		for (int i = 0; i < n; i++)
+			order[i] = i;
+		stable_sort(order.begin(), order.end(), [&](int a, int b)
+					{ return wins[a] > wins[b]; });
+		for (int k = 0; k < n; k++)
+			position[order[k]] = k;
+		total.assign(n + 1, 0);
+		best.assign(n + 1, 0);
+		for (int k = 1; k <= n; k++)
 		{
-			cout<<"TRIVIAL"<<endl;
-			cout << d.getTeamNames()[i] << " is eliminated.\nThey can win at most " << d.getWins()[i] << " + " << d.getLeft()[i] << " = " << d.getWins()[i] + d.getLeft()[i] << " games.\n"
-				 << d.getTeamNames()[max] << " has won a total of " << d.getWins()[max] << " games.\nThey play each other 0 times.\nSo on average, each of the teams in this group wins " << d.getWins()[max] << "/1 = " << d.getWins()[max] << " games.\n\n";
+			// Only the newcomer's wins and its games against the teams already
+			// in the prefix are new; everything else carries over from total[k - 1].
+			int team = order[k - 1];
+			long long added = wins[team];
+			for (int j = 0; j < k - 1; j++)
+				added += d.getGames(order[j], team);
+			total[k] = total[k - 1] + added;
+			int b = best[k - 1];
+			best[k] = (b == 0 || total[k] * b > total[b] * k) ? k : b;
 		}
-		else
+	}
+
+	// Teams of a prefix that eliminates team i with the given ceiling, by index; empty if none.
+	vector<int> eliminatingSet(int i, int ceiling) const
+	{
+		int k = best[position[i]];
+		vector<int> teams;
+		if (k > 0 && total[k] > (long long)ceiling * k)
 		{
-			cout<<"NON TRIVIAL"<<endl;
-			// cout << "ff" << " " << ix << endl;
-			ix++;
-			flowNetwork fn(d, i);
-			fn.maxFlowFordFulkerson(d);
+			teams.assign(order.begin(), order.begin() + k);
+			sort(teams.begin(), teams.end());
 		}
+		return teams;
 	}
+};
+
+// Writes the full report for team i to out; returns true when the team is not eliminated.
+// With verbose set, the report is tagged with the team's index and the check that settled it.
+bool analyzeTeam(divison d, int i, int max, const prefixBound &bound, bool verbose, ostream &out)
+{
+	if (verbose)
+		out << "I" << i << endl;
+	if (d.getWins()[i] + d.getLeft()[i] < d.getWins()[max])
+	{
+		if (verbose)
+			out << "TRIVIAL" << endl;
+		out << d.getTeamNames()[i] << " is eliminated.\nThey can win at most " << d.getWins()[i] << " + " << d.getLeft()[i] << " = " << d.getWins()[i] + d.getLeft()[i] << " games.\n"
+			<< d.getTeamNames()[max] << " has won a total of " << d.getWins()[max] << " games.\nThey play each other 0 times.\nSo on average, each of the teams in this group wins " << d.getWins()[max] << "/1 = " << d.getWins()[max] << " games.\n\n";
+		return false;
+	}
+	int ceiling = d.getWins()[i] + d.getLeft()[i];
+	vector<int> group = bound.eliminatingSet(i, ceiling);
+	if (!group.empty())
+	{
+		if (verbose)
+			out << "PREFIX" << endl;
+		vector<string> tn = d.getTeamNames();
+		int wins = 0, remain = 0;
+		out << tn[i] << " is eliminated.\nThey can win at most " << d.getWins()[i] << " + " << d.getLeft()[i] << " = " << ceiling << " games.\n";
+		out << tn[group[0]];
+		for (size_t k = 0; k < group.size(); k++)
+		{
+			wins += d.getWins()[group[k]];
+			for (size_t l = k + 1; l < group.size(); l++)
+				remain += d.getGames(group[k], group[l]);
+			if (k != 0 && k != group.size() - 1)
+				out << ", " << tn[group[k]];
+			else if (k != 0)
+				out << " and " << tn[group[k]];
+		}
+		out << " have won a total of " << wins << " games.\nThey play each other " << remain << " times.\nSo on average, each of the team wins " << wins + remain << "/" << group.size() << " = " << float(wins + remain) / float(group.size()) << " games.\n\n";
+		return false;
+	}
+	if (verbose)
+		out << "NON TRIVIAL" << endl;
+	flowNetwork fn(d, i);
+	return fn.maxFlowFordFulkerson(d, out);
+}
+
+// Teams are independent, so worker threads claim team indices from a shared
+// counter; reports are buffered per team and printed in team order.
+void eliminate(divison d, int n, int max, int min, int threads, bool verbose)
+{
+	vector<string> reports(n);
+	vector<char> alive(n, 0);
+	atomic<int> next(0);
+	prefixBound bound(d);
+	auto worker = [&]()
+	{
+		for (int i = next++; i < n; i = next++)
+		{
+			ostringstream out;
+			alive[i] = analyzeTeam(d, i, max, bound, verbose, out);
+			reports[i] = out.str();
+		}
+	};
+	vector<thread> pool;
+	for (int t = 1; t < threads; t++)
+		pool.emplace_back(worker);
+	worker();
+	for (auto &t : pool)
+		t.join();
+
+	int notEliminated = 0;
+	for (int i = 0; i < n; i++)
+	{
+		cout << reports[i];
+		notEliminated += alive[i];
+	}
+	if (notEliminated == n)
+		cout << "No team is eliminated." << endl;
 }
 
-int main()
+// Usage: main [--threads N] [--verbose] [file]
+int main(int argc, char *argv[])
 {
 	string filename;
-	cout << "Enter File Name:\n";
-	cin >> filename;
-	cout << endl;
+	int threads = 1;
+	bool verbose = false;
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "--threads" && i + 1 < argc)
+			threads = stringToNumber(argv[++i]);
+		else if (arg == "--verbose")
+			verbose = true;
+		else
+			filename = arg;
+	}
+	if (threads < 1)
+		threads = 1;
+	if (filename.empty())
+	{
+		cout << "Enter File Name:\n";
+		cin >> filename;
+		cout << endl;
+	}
 	vector<string> input = txtToString(filename);
 	try
 	{
@@ -390,9 +552,13 @@ int main()
 					minpos = i;
 				}
 			}
-			eliminate(div, div.getNTeams(), maxpos, minpos);
+			eliminate(div, div.getNTeams(), maxpos, minpos, threads, verbose);
 		}
 	}
+	catch (string message)
+	{
+		cout << __FILE__ << ": error: " << message << "\n";
+	}
 	catch (int x)
 	{
 		if (x == -1)
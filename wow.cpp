@@ -8,386 +8,4122 @@
 #include <stdexcept>
 #include <algorithm>
 #include <climits>
+#include <limits>
+#include <array>
 #include <numeric>
 #include <set>
+#include <iomanip>
+#include <memory>
+#include <variant>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <charconv>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace std;
 
 // -----------------------------
-// Division Class
+// Allocation Counter
 // -----------------------------
-class Division {
-private:
-    int numTeams;
-    vector<string> teamNames;
-    vector<int> wins;
-    vector<int> losses;
-    vector<int> remainingGames;
-    vector<vector<int>> gamesAgainstMatrix;
+// Global operator new counts the heap allocations of the calling thread, so
+// --stats can report them per team. The counter is a plain thread-local
+// increment and costs next to nothing when nobody reads it. Every new/delete
+// form is replaced so all of them share one malloc/free pair; the operators
+// stay out of line so GCC does not flag malloc/free as a new/delete mismatch.
+thread_local long long threadAllocations = 0;
 
-    int stringToNumber(const string& s) const {
-        return stoi(s);
+static void* countedAllocate(size_t size, size_t alignment) noexcept {
+    threadAllocations++;
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(max_align_t)) {
+        return malloc(size);
     }
+    void* p = nullptr;
+    return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+}
 
-public:
-    Division(const string& filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            throw runtime_error("Error: File '" + filename + "' does not exist.");
-        }
+static void* countedAllocateOrThrow(size_t size, size_t alignment) {
+    if (void* p = countedAllocate(size, alignment)) {
+        return p;
+    }
+    throw bad_alloc();
+}
 
-        string line;
-        // Read number of teams
-        if (!getline(file, line)) {
-            throw runtime_error("Error: The input file is empty.");
-        }
+[[gnu::noinline]] void* operator new(size_t size) {
+    return countedAllocateOrThrow(size, alignof(max_align_t));
+}
 
-        numTeams = stringToNumber(line);
-        if (numTeams < 2) {
-            throw runtime_error("Error: At least two teams are required.");
-        }
+[[gnu::noinline]] void* operator new[](size_t size) {
+    return countedAllocateOrThrow(size, alignof(max_align_t));
+}
 
-        // Read team data
-        while (getline(file, line)) {
-            if (line.empty()) continue; // Skip empty lines
-            istringstream ss(line);
-            string team;
-            int win, loss, remaining;
-            if (!(ss >> team >> win >> loss >> remaining)) {
-                throw runtime_error("Error: Invalid data format for team statistics.");
-            }
+[[gnu::noinline]] void* operator new(size_t size, align_val_t alignment) {
+    return countedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
 
-            vector<int> gamesAgainst;
-            for (int i = 0; i < numTeams; ++i) {
-                int games;
-                if (!(ss >> games)) {
-                    throw runtime_error("Error: Insufficient games against data for team " + team);
-                }
-                gamesAgainst.push_back(games);
-            }
+[[gnu::noinline]] void* operator new[](size_t size, align_val_t alignment) {
+    return countedAllocateOrThrow(size, static_cast<size_t>(alignment));
+}
 
-            // Data consistency check
-            int totalGamesAgainst = accumulate(gamesAgainst.begin(), gamesAgainst.end(), 0);
-            if (totalGamesAgainst != remaining) {
-                throw runtime_error("Error: Total games against other teams does not match remaining games for team " + team);
-            }
+[[gnu::noinline]] void* operator new(size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size, alignof(max_align_t));
+}
+
+[[gnu::noinline]] void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return countedAllocate(size, alignof(max_align_t));
+}
+
+[[gnu::noinline]] void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return countedAllocate(size, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, align_val_t) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p, align_val_t) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, size_t, align_val_t) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p, size_t, align_val_t) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, const nothrow_t&) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p, const nothrow_t&) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, align_val_t, const nothrow_t&) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept {
+    free(p);
+}
+
+// -----------------------------
+// MappedFile Class
+// -----------------------------
+// Read-only memory mapping of a whole file, unmapped on destruction.
+class MappedFile {
+private:
+    const char* bytes;
+    size_t length;
 
-            teamNames.push_back(team);
-            wins.push_back(win);
-            losses.push_back(loss);
-            remainingGames.push_back(remaining);
-            gamesAgainstMatrix.push_back(gamesAgainst);
+public:
+    MappedFile(const string& filename) : bytes(nullptr), length(0) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("Error: File '" + filename + "' does not exist.");
         }
 
-        // Validate input
-        if (teamNames.size() != numTeams) {
-            throw runtime_error("Error: Mismatch between number of teams and team data provided.");
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw runtime_error("Error: Cannot read file '" + filename + "'.");
         }
 
-        file.close();
+        length = info.st_size;
+        if (length > 0) {
+            void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                close(fd);
+                throw runtime_error("Error: Cannot map file '" + filename + "'.");
+            }
+            madvise(mapped, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(mapped);
+        }
+        close(fd);
     }
 
-    // Getter methods
-    int getNumTeams() const { return numTeams; }
-    const vector<string>& getTeamNames() const { return teamNames; }
-    const vector<int>& getWins() const { return wins; }
-    const vector<int>& getLosses() const { return losses; }
-    const vector<int>& getRemainingGames() const { return remainingGames; }
-    const vector<vector<int>>& getGamesAgainstMatrix() const { return gamesAgainstMatrix; }
+    ~MappedFile() {
+        if (bytes) {
+            munmap(const_cast<char*>(bytes), length);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return bytes; }
+    const char* end() const { return bytes + length; }
+    size_t size() const { return length; }
 };
 
 // -----------------------------
-// Graph Class
+// StandingsParser Class
 // -----------------------------
-class Graph {
+// Single-pass tokenizer over the mapped standings text. Tokens never cross a
+// line break, and every error carries the line and column it was found at.
+class StandingsParser {
 private:
-    int numVertices;
-    vector<vector<int>> capacityMatrix;
+    const char* cursor;
+    const char* limit;
+    const char* lineStart;
+    int lineNumber;
 
 public:
-    Graph(int vertices) : numVertices(vertices), capacityMatrix(vertices, vector<int>(vertices, 0)) {}
+    StandingsParser(const char* begin, const char* end)
+        : cursor(begin), limit(end), lineStart(begin), lineNumber(1) {}
 
-    void addEdge(int from, int to, int capacity) {
-        capacityMatrix[from][to] = capacity;
+    [[noreturn]] void fail(const string& message) const {
+        throw runtime_error("Error: Line " + to_string(lineNumber) + ", column " +
+                            to_string(cursor - lineStart + 1) + ": " + message);
     }
 
-    const vector<vector<int>>& getCapacityMatrix() const { return capacityMatrix; }
-    int getNumVertices() const { return numVertices; }
+    int getLineNumber() const { return lineNumber; }
+
+    void skipSpaces() {
+        while (cursor < limit && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+            cursor++;
+        }
+    }
+
+    bool atLineEnd() {
+        skipSpaces();
+        return cursor == limit || *cursor == '\n';
+    }
+
+    bool atEnd() const { return cursor == limit; }
+
+    // Moves to the next line with content; false when only blank lines remain.
+    bool skipBlankLines() {
+        while (!atEnd() && atLineEnd()) {
+            nextLine();
+        }
+        return !atEnd();
+    }
+
+    // Moves past the rest of the current line, ignoring anything left on it.
+    void nextLine() {
+        while (cursor < limit && *cursor != '\n') {
+            cursor++;
+        }
+        if (cursor < limit) {
+            cursor++;
+            lineStart = cursor;
+            lineNumber++;
+        }
+    }
+
+    string readName() {
+        if (atLineEnd()) {
+            fail("Expected a team name.");
+        }
+        const char* start = cursor;
+        while (cursor < limit && !isspace(static_cast<unsigned char>(*cursor))) {
+            cursor++;
+        }
+        return string(start, cursor);
+    }
+
+    // `what` names the value in error messages; a nonnegative `number` is
+    // appended to it there ("games against team 3"), so callers never build
+    // a label per token. Values above `maxValue` are rejected.
+    long long readNumber(const char* what, long long maxValue, int number = -1) {
+        auto label = [&] { return number < 0 ? string(what) : string(what) + " " + to_string(number); };
+        if (atLineEnd()) {
+            fail("Expected " + label() + ".");
+        }
+        if (*cursor < '0' || *cursor > '9') {
+            fail("Expected " + label() + ", found '" + *cursor + "'.");
+        }
+        long long value = 0;
+        while (cursor < limit && *cursor >= '0' && *cursor <= '9') {
+            if (value > (maxValue - (*cursor - '0')) / 10) {
+                fail("Value of " + label() + " is too large.");
+            }
+            value = value * 10 + (*cursor - '0');
+            cursor++;
+        }
+        if (cursor < limit && !isspace(static_cast<unsigned char>(*cursor))) {
+            fail("Unexpected character '" + string(1, *cursor) + "' in " + label() + ".");
+        }
+        return value;
+    }
+
+    int readInt(const char* what, int number = -1) {
+        return static_cast<int>(readNumber(what, INT_MAX, number));
+    }
 };
 
 // -----------------------------
-// Ford-Fulkerson Class (Edmonds-Karp Algorithm)
+// Schedule Class
 // -----------------------------
-class FordFulkerson {
+// Remaining fixtures of a division, stored sparsely. Only pairs that have
+// games left are kept, as a symmetric adjacency list in CSR form: team t's
+// opponents are the entries [entryBegin(t), entryEnd(t)), sorted by opponent,
+// and the entries from upperEntryBegin(t) on are the opponents above t, so
+// walking those visits every fixture once in (i, j) order. Game counts are
+// 16-bit. Fixtures are staged with addFixture() and packed by finalize(), or
+// packed straight from an ordered source by assignSorted(); playing a pair
+// out leaves its entry in place with zero games.
+class Schedule {
+public:
+    using GameCount = uint16_t;
+    static constexpr int maxGamesPerPair = numeric_limits<GameCount>::max();
+
 private:
-    const Graph& graph;
-    int source;
-    int sink;
-    vector<int> parent;
-    vector<vector<int>> residual;
+    struct PendingFixture {
+        int teamI;
+        int teamJ;
+        int games;
 
-    bool bfs() {
-        parent.assign(graph.getNumVertices(), -1);
-        parent[source] = -2;
-        queue<int> q;
-        q.push(source);
-
-        while (!q.empty()) {
-            int current = q.front();
-            q.pop();
-
-            for (int next = 0; next < graph.getNumVertices(); ++next) {
-                if (parent[next] == -1 && residual[current][next] > 0) {
-                    parent[next] = current;
-                    if (next == sink) {
-                        return true;
-                    }
-                    q.push(next);
-                }
-            }
+        bool operator<(const PendingFixture& other) const {
+            return teamI != other.teamI ? teamI < other.teamI : teamJ < other.teamJ;
         }
-        return false;
+    };
+
+    int numTeams;
+    vector<uint32_t> entryStart;    // entries of team t are [entryStart[t], entryStart[t + 1])
+    vector<uint32_t> upperStart;    // first entry of team t whose opponent is above t
+    vector<uint32_t> opponent;
+    vector<GameCount> games;
+    vector<PendingFixture> pendingFixtures;
+
+    // Entry of `j` in team i's list, or -1.
+    int findEntry(int i, int j) const {
+        auto first = opponent.begin() + entryStart[i];
+        auto last = opponent.begin() + entryStart[i + 1];
+        auto it = lower_bound(first, last, uint32_t(j));
+        return (it != last && *it == uint32_t(j)) ? int(it - opponent.begin()) : -1;
     }
 
 public:
-    FordFulkerson(const Graph& g, int s, int t)
-        : graph(g), source(s), sink(t), parent(g.getNumVertices(), -1), residual(g.getCapacityMatrix()) {}
+    Schedule(int teams = 0) : numTeams(teams), entryStart(teams + 1, 0), upperStart(teams, 0) {}
 
-    int getMaxFlow() {
-        int maxFlow = 0;
+    // Stages `count` games between teams i and j (i != j, either order).
+    void addFixture(int i, int j, int count) {
+        if (i == j || i < 0 || j < 0 || i >= numTeams || j >= numTeams || count < 0 || count > maxGamesPerPair) {
+            throw runtime_error("Error: Invalid fixture between teams " + to_string(i + 1) + " and " + to_string(j + 1) + ".");
+        }
+        if (count > 0) {
+            pendingFixtures.push_back({min(i, j), max(i, j), count});
+        }
+    }
 
-        while (bfs()) {
-            // Find bottleneck capacity
-            int pathFlow = INT_MAX;
-            for (int v = sink; v != source; v = parent[v]) {
-                int u = parent[v];
-                pathFlow = min(pathFlow, residual[u][v]);
+    void finalize() {
+        sort(pendingFixtures.begin(), pendingFixtures.end());
+        for (size_t f = 1; f < pendingFixtures.size(); ++f) {
+            if (!(pendingFixtures[f - 1] < pendingFixtures[f])) {
+                throw runtime_error("Error: Duplicate fixture between teams " + to_string(pendingFixtures[f].teamI + 1) +
+                                    " and " + to_string(pendingFixtures[f].teamJ + 1) + ".");
             }
+        }
 
-            // Update residual capacities
-            for (int v = sink; v != source; v = parent[v]) {
-                int u = parent[v];
-                residual[u][v] -= pathFlow;
-                residual[v][u] += pathFlow;
+        assignSorted([&](auto visit) {
+            for (const auto& f : pendingFixtures) {
+                visit(f.teamI, f.teamJ, f.games);
             }
+        });
 
-            maxFlow += pathFlow;
+        pendingFixtures.clear();
+        pendingFixtures.shrink_to_fit();
+    }
+
+    // Packs the lists from fixtures the caller has already checked: i < j,
+    // (i, j) strictly increasing, 1 to maxGamesPerPair games.
+    // forEachFixture(visit) must call visit(i, j, games) for each of them
+    // and is run twice, once to count and once to fill.
+    template <typename ForEachFixture>
+    void assignSorted(ForEachFixture forEachFixture) {
+        entryStart.assign(numTeams + 1, 0);
+        forEachFixture([&](int i, int j, int) {
+            entryStart[i + 1]++;
+            entryStart[j + 1]++;
+        });
+        for (int t = 0; t < numTeams; ++t) {
+            entryStart[t + 1] += entryStart[t];
         }
 
-        return maxFlow;
+        // Sorted input fills every team's list in ascending opponent order:
+        // a team's lower opponents all come from earlier fixtures than its
+        // upper ones.
+        opponent.assign(entryStart[numTeams], 0);
+        games.assign(entryStart[numTeams], 0);
+        vector<uint32_t> nextEntry(entryStart.begin(), entryStart.end() - 1);
+        upperStart.assign(entryStart.begin() + 1, entryStart.end());
+        forEachFixture([&](int i, int j, int count) {
+            uint32_t forward = nextEntry[i]++;
+            uint32_t backward = nextEntry[j]++;
+            opponent[forward] = j;
+            opponent[backward] = i;
+            games[forward] = games[backward] = count;
+            upperStart[i] = min(upperStart[i], forward);
+        });
     }
 
-    const vector<vector<int>>& getResidualGraph() const {
-        return residual;
+    int getNumTeams() const { return numTeams; }
+    int entryBegin(int team) const { return entryStart[team]; }
+    int upperEntryBegin(int team) const { return upperStart[team]; }
+    int entryEnd(int team) const { return entryStart[team + 1]; }
+    int opponentAt(int entry) const { return opponent[entry]; }
+    int gamesAt(int entry) const { return games[entry]; }
+
+    int gamesBetween(int i, int j) const {
+        int entry = (i == j) ? -1 : findEntry(i, j);
+        return entry < 0 ? 0 : games[entry];
     }
 
-    const vector<int>& getParent() const {
-        return parent;
+    // Entry of `team` in the list of the opponent at `entry`, which is in team's list.
+    int mirrorEntry(int team, int entry) const {
+        return findEntry(opponent[entry], team);
+    }
+
+    // Removes one game between i and j; the caller checks one is left.
+    void playGame(int i, int j) {
+        games[findEntry(i, j)]--;
+        games[findEntry(j, i)]--;
     }
 };
 
 // -----------------------------
-// FlowNetwork Class
+// Division Class
 // -----------------------------
-class FlowNetwork {
+// Wins, losses and remaining games are 64-bit so that cumulative standings
+// over many seasons load as they are.
+class Division {
+public:
+    // Largest wins, losses or remaining games accepted. It keeps every
+    // ceiling and every league-wide total well inside 64 bits.
+    static constexpr long long maxStandingsValue = 1LL << 40;
+
 private:
-    Graph graph;
-    int source;
-    int sink;
-    int teamIndex; // Index of the team being analyzed
     int numTeams;
-    int numGames;
-    int gameNodeStart;
-    int teamNodeStart;
     vector<string> teamNames;
-    vector<int> wins;
-    vector<int> remainingGames;
-
-    int adjustedTeamNode(int originalIndex) const {
-        return teamNodeStart + originalIndex - (originalIndex > teamIndex ? 1 : 0);
-    }
+    vector<long long> wins;
+    vector<long long> losses;
+    vector<long long> remainingGames;
+    Schedule schedule;
 
-public:
-    FlowNetwork(const Division& division, int teamIdx)
-        : teamIndex(teamIdx),
-          teamNames(division.getTeamNames()),
-          wins(division.getWins()),
-          remainingGames(division.getRemainingGames()),
-          numTeams(division.getNumTeams()),
-          numGames(0),  // Initialize to 0, will calculate in the constructor body
-          graph(1),  // Temporary initialization, will be properly set later
-          source(0),
-          sink(1)  // Temporary value, will be updated
-    {
-        // Calculate number of game nodes
-        const auto& gamesAgainst = division.getGamesAgainstMatrix();
-        for (int i = 0; i < numTeams; ++i) {
-            for (int j = i + 1; j < numTeams; ++j) {
-                if (i != teamIndex && j != teamIndex) {
-                    int gamesLeft = gamesAgainst[i][j];
-                    if (gamesLeft > 0) {
-                        numGames++;
-                    }
-                }
-            }
+    // Reads one division and leaves the parser on the line after its last
+    // team, so several divisions can follow each other in one file.
+    void loadText(StandingsParser& parser) {
+        // Read number of teams
+        numTeams = parser.readInt("the number of teams");
+        if (numTeams < 2) {
+            throw runtime_error("Error: At least two teams are required.");
         }
+        parser.nextLine();
 
-        // Total nodes = source + game nodes + team nodes + sink
-        int totalNodes = 2 + numGames + (numTeams - 1);
-        
-        // Properly initialize the graph with the correct number of nodes
-        graph = Graph(totalNodes);
-        sink = totalNodes - 1;
+        teamNames.reserve(numTeams);
+        wins.reserve(numTeams);
+        losses.reserve(numTeams);
+        remainingGames.reserve(numTeams);
+        schedule = Schedule(numTeams);
 
-        gameNodeStart = 1;
-        teamNodeStart = gameNodeStart + numGames;
+        // Entries below the diagonal must mirror the ones above it; they are
+        // collected as (lower, upper, games) and compared once all rows are in.
+        vector<array<int, 3>> mirrored;
 
-        // Add edges from source to game nodes and from game nodes to team nodes
-        int gameNode = gameNodeStart;
-        for (int i = 0; i < numTeams; ++i) {
-            if (i == teamIndex) continue;
-            for (int j = i + 1; j < numTeams; ++j) {
-                if (j == teamIndex) continue;
-                int gamesLeft = gamesAgainst[i][j];
-                if (gamesLeft > 0) {
-                    // Edge from source to game node
-                    graph.addEdge(source, gameNode, gamesLeft);
+        // Read team data
+        int teamsRead = 0;
+        for (; teamsRead < numTeams && !parser.atEnd(); parser.nextLine()) {
+            if (parser.atLineEnd()) continue; // Skip empty lines
+            int lineNumber = parser.getLineNumber();
 
-                    // Edges from game node to team nodes
-                    int teamNodeI = adjustedTeamNode(i);
-                    int teamNodeJ = adjustedTeamNode(j);
-                    graph.addEdge(gameNode, teamNodeI, INT_MAX);
-                    graph.addEdge(gameNode, teamNodeJ, INT_MAX);
+            teamNames.push_back(parser.readName());
+            const string& team = teamNames.back();
+            wins.push_back(parser.readNumber("wins", maxStandingsValue));
+            losses.push_back(parser.readNumber("losses", maxStandingsValue));
+            remainingGames.push_back(parser.readNumber("remaining games", maxStandingsValue));
 
-                    gameNode++;
+            int row = teamsRead;
+            long long totalGamesAgainst = 0;
+            for (int i = 0; i < numTeams; ++i) {
+                int gamesAgainst = parser.readInt("games against team", i + 1);
+                totalGamesAgainst += gamesAgainst;
+                if (gamesAgainst == 0) continue;
+                if (i == row) {
+                    throw runtime_error("Error: Line " + to_string(lineNumber) + ": Team " + team + " cannot have games against itself.");
+                }
+                if (gamesAgainst > Schedule::maxGamesPerPair) {
+                    throw runtime_error("Error: Line " + to_string(lineNumber) + ": More than " +
+                                        to_string(Schedule::maxGamesPerPair) + " games left between two teams.");
+                }
+                if (i > row) {
+                    schedule.addFixture(row, i, gamesAgainst);
+                } else {
+                    mirrored.push_back({i, row, gamesAgainst});
                 }
             }
+
+            // Data consistency check
+            if (totalGamesAgainst != remainingGames.back()) {
+                throw runtime_error("Error: Line " + to_string(lineNumber) +
+                                    ": Total games against other teams does not match remaining games for team " + team);
+            }
+            teamsRead++;
         }
 
-        // Calculate the maximum number of games Team X can win
-        int maxPossibleWins = wins[teamIndex] + remainingGames[teamIndex];
+        // Validate input
+        if (teamsRead != numTeams) {
+            throw runtime_error("Error: Mismatch between number of teams and team data provided.");
+        }
+        schedule.finalize();
+        checkMirrored(mirrored);
+    }
 
-        // Add edges from team nodes to sink
+    // `mirrored` holds the nonzero entries found below the diagonal; sorted,
+    // it must match the upper fixtures one for one, counts included.
+    void checkMirrored(vector<array<int, 3>>& mirrored) const {
+        sort(mirrored.begin(), mirrored.end());
+        size_t next = 0;
         for (int i = 0; i < numTeams; ++i) {
-            if (i == teamIndex) continue;
-            int capacity = maxPossibleWins - wins[i];
-            if (capacity < 0) {
-                capacity = 0; // Team already has more wins than Team X can achieve
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                array<int, 3> fixture = {i, schedule.opponentAt(e), schedule.gamesAt(e)};
+                if (next == mirrored.size() || mirrored[next] != fixture) {
+                    if (next < mirrored.size() && mirrored[next] < fixture) {
+                        fixture = mirrored[next];
+                    }
+                    throwAsymmetric(fixture[0], fixture[1]);
+                }
+                next++;
             }
-            int teamNode = adjustedTeamNode(i);
-            graph.addEdge(teamNode, sink, capacity);
+        }
+        if (next < mirrored.size()) {
+            throwAsymmetric(mirrored[next][0], mirrored[next][1]);
         }
     }
 
-    bool isEliminated(bool verbose = false) const {
-        // Run Ford-Fulkerson algorithm
-        FordFulkerson ff(graph, source, sink);
-        int maxFlow = ff.getMaxFlow();
+    [[noreturn]] void throwAsymmetric(int i, int j) const {
+        throw runtime_error("Error: Games between " + teamNames[i] + " and " + teamNames[j] + " are not symmetric.");
+    }
 
-        // Calculate total remaining games (from source)
-        int totalGames = 0;
-        const auto& capacityMatrix = graph.getCapacityMatrix();
-        for (int capacity : capacityMatrix[source]) {
-            totalGames += capacity;
-        }
 
-        if (verbose) {
-            cout << "Team: " << teamNames[teamIndex] << endl;
-            cout << "Max Flow: " << maxFlow << endl;
-            cout << "Total Remaining Games: " << totalGames << endl;
-        }
+    // Binary layout, native byte order, every section 4-byte aligned:
+    //   DivisionFileHeader
+    //   uint32_t nameOffsets[numTeams + 1]  (into the name table)
+    //   char     nameTable[nameBytes]       (padded to a multiple of 4)
+    //   int64_t  wins[numTeams], losses[numTeams], remaining[numTeams]
+    // then the schedule in whichever layout is smaller:
+    //   SparseSchedule: the upper fixtures as CSR, (i, j) ascending
+    //     uint32_t fixtureStart[numTeams + 1]  (team i's are [fixtureStart[i], fixtureStart[i + 1]))
+    //     uint32_t opponent[numFixtures]       (above i, ascending)
+    //     uint16_t games[numFixtures]          (nonzero, padded to a multiple of 4 bytes)
+    //   TriangularSchedule: every pair i < j, row by row
+    //     uint16_t games[numTeams * (numTeams - 1) / 2]  (padded to a multiple of 4 bytes)
+    struct DivisionFileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t numTeams;
+        uint32_t numFixtures;       // pairs with games left
+        uint32_t nameBytes;
+        uint32_t scheduleLayout;
+    };
 
-        return maxFlow < totalGames;
-    }
+    enum ScheduleLayout : uint32_t {
+        SparseSchedule = 0,
+        TriangularSchedule = 1
+    };
 
-    vector<string> getEliminationCertificate() const {
-        // Run Ford-Fulkerson algorithm
-        FordFulkerson ff(graph, source, sink);
-        ff.getMaxFlow();
+    static constexpr char binaryMagic[8] = {'S', 'X', 'D', 'I', 'V', 'B', 'I', 'N'};
+    static constexpr uint32_t binaryVersion = 3;
 
-        // Perform a BFS on the residual graph to find the reachable nodes from source
-        vector<bool> visited(graph.getNumVertices(), false);
-        queue<int> q;
-        q.push(source);
-        visited[source] = true;
+    static size_t alignTo4(size_t n) { return (n + 3) & ~size_t(3); }
 
-        const auto& residual = ff.getResidualGraph();
+    void loadBinary(const MappedFile& file) {
+        const char* base = file.begin();
+        size_t size = file.size();
+        auto section = [&](size_t offset, size_t bytes) {
+            if (offset + bytes > size) {
+                throw runtime_error("Error: Binary division file is truncated.");
+            }
+            return base + offset;
+        };
+
+        DivisionFileHeader header;
+        memcpy(&header, section(0, sizeof header), sizeof header);
+        if (header.version != binaryVersion) {
+            throw runtime_error("Error: Unsupported binary division version " + to_string(header.version) + ".");
+        }
+        if (header.numTeams < 2 || header.numTeams > INT_MAX) {
+            throw runtime_error("Error: At least two teams are required.");
+        }
+        numTeams = header.numTeams;
 
-        while (!q.empty()) {
-            int current = q.front();
-            q.pop();
+        size_t offset = sizeof header;
+        const uint32_t* nameOffsets = reinterpret_cast<const uint32_t*>(section(offset, (numTeams + 1) * sizeof(uint32_t)));
+        offset += (numTeams + 1) * sizeof(uint32_t);
+        const char* nameTable = section(offset, header.nameBytes);
+        offset += alignTo4(header.nameBytes);
 
-            for (int next = 0; next < graph.getNumVertices(); ++next) {
-                if (!visited[next] && residual[current][next] > 0) {
-                    visited[next] = true;
-                    q.push(next);
-                }
+        teamNames.resize(numTeams);
+        for (int i = 0; i < numTeams; ++i) {
+            if (nameOffsets[i] > nameOffsets[i + 1] || nameOffsets[i + 1] > header.nameBytes) {
+                throw runtime_error("Error: Corrupt team name table in binary division file.");
             }
+            teamNames[i].assign(nameTable + nameOffsets[i], nameTable + nameOffsets[i + 1]);
         }
 
-        // Collect team nodes that are reachable from the source
-        vector<string> certificate;
-        for (int i = 0; i < numTeams; ++i) {
-            if (i == teamIndex) continue;
-            int teamNode = adjustedTeamNode(i);
-            if (visited[teamNode]) {
-                certificate.push_back(teamNames[i]);
+        for (vector<long long>* column : {&wins, &losses, &remainingGames}) {
+            column->resize(numTeams);
+            memcpy(column->data(), section(offset, numTeams * sizeof(int64_t)), numTeams * sizeof(int64_t));
+            offset += numTeams * sizeof(int64_t);
+            for (long long value : *column) {
+                if (value < 0 || value > maxStandingsValue) {
+                    throw runtime_error("Error: Corrupt standings in binary division file.");
+                }
             }
         }
 
-        return certificate;
+        schedule = Schedule(numTeams);
+        if (header.scheduleLayout == SparseSchedule) {
+            uint32_t numFixtures = header.numFixtures;
+            const uint32_t* fixtureStart = reinterpret_cast<const uint32_t*>(section(offset, (numTeams + 1) * sizeof(uint32_t)));
+            offset += (numTeams + 1) * sizeof(uint32_t);
+            const uint32_t* opponents = reinterpret_cast<const uint32_t*>(section(offset, numFixtures * sizeof(uint32_t)));
+            offset += numFixtures * sizeof(uint32_t);
+            const uint16_t* fixtureGames = reinterpret_cast<const uint16_t*>(section(offset, numFixtures * sizeof(uint16_t)));
+
+            // The writer's order is what assignSorted() needs, so it is only checked
+            if (fixtureStart[0] != 0 || fixtureStart[numTeams] != numFixtures) {
+                throw runtime_error("Error: Corrupt fixture table in binary division file.");
+            }
+            for (int i = 0; i < numTeams; ++i) {
+                if (fixtureStart[i] > fixtureStart[i + 1]) {
+                    throw runtime_error("Error: Corrupt fixture table in binary division file.");
+                }
+                uint32_t previous = i;
+                for (uint32_t f = fixtureStart[i]; f < fixtureStart[i + 1]; ++f) {
+                    if (opponents[f] <= previous || opponents[f] >= header.numTeams || fixtureGames[f] == 0) {
+                        throw runtime_error("Error: Corrupt fixture " + to_string(f) + " in binary division file.");
+                    }
+                    previous = opponents[f];
+                }
+            }
+            loadSchedule([&](auto visit) {
+                for (int i = 0; i < numTeams; ++i) {
+                    for (uint32_t f = fixtureStart[i]; f < fixtureStart[i + 1]; ++f) {
+                        visit(i, int(opponents[f]), int(fixtureGames[f]));
+                    }
+                }
+            });
+        } else if (header.scheduleLayout == TriangularSchedule) {
+            size_t numPairs = size_t(numTeams) * (numTeams - 1) / 2;
+            const uint16_t* triangle = reinterpret_cast<const uint16_t*>(section(offset, numPairs * sizeof(uint16_t)));
+            loadSchedule([&](auto visit) {
+                const uint16_t* pair = triangle;
+                for (int i = 0; i < numTeams; ++i) {
+                    for (int j = i + 1; j < numTeams; ++j, ++pair) {
+                        if (*pair > 0) {
+                            visit(i, j, int(*pair));
+                        }
+                    }
+                }
+            });
+        } else {
+            throw runtime_error("Error: Unknown schedule layout " + to_string(header.scheduleLayout) + " in binary division file.");
+        }
     }
-};
 
-// -----------------------------
-// Main Function
-// -----------------------------
-int main() {
-    string filename;
-    cout << "Enter the input file name: ";
-    cin >> filename;
-    cout << endl;
+    // Checks the fixtures against the remaining games and packs them.
+    template <typename ForEachFixture>
+    void loadSchedule(ForEachFixture forEachFixture) {
+        vector<long long> totalGamesAgainst(numTeams, 0);
+        forEachFixture([&](int i, int j, int count) {
+            totalGamesAgainst[i] += count;
+            totalGamesAgainst[j] += count;
+        });
 
-    try {
-        Division division(filename);
-        int numTeams = division.getNumTeams();
+        // Data consistency check
+        for (int i = 0; i < numTeams; ++i) {
+            if (totalGamesAgainst[i] != remainingGames[i]) {
+                throw runtime_error("Error: Total games against other teams does not match remaining games for team " + teamNames[i]);
+            }
+        }
+        schedule.assignSorted(forEachFixture);
+    }
 
-        for (int teamIndex = 0; teamIndex < numTeams; ++teamIndex) {
-            // Trivial elimination check
-            int maxPossibleWins = division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex];
-            bool triviallyEliminated = false;
-            string eliminationReason = "";
+    static bool hasBinaryMagic(const MappedFile& file) {
+        return file.size() >= sizeof binaryMagic && memcmp(file.begin(), binaryMagic, sizeof binaryMagic) == 0;
+    }
 
-            for (int i = 0; i < numTeams; ++i) {
-                if (i == teamIndex) continue;
-                if (division.getWins()[i] > maxPossibleWins) {
-                    triviallyEliminated = true;
-                    eliminationReason = division.getTeamNames()[i] + " already has more wins than " + division.getTeamNames()[teamIndex] + " can achieve.";
-                    break;
-                }
+public:
+    // Accepts either the text standings format or the binary format written
+    // by writeBinary(); the binary magic decides which.
+    Division(const string& filename) {
+        MappedFile file(filename);
+        if (file.size() == 0) {
+            throw runtime_error("Error: The input file is empty.");
+        }
+        if (hasBinaryMagic(file)) {
+            loadBinary(file);
+        } else {
+            StandingsParser parser(file.begin(), file.end());
+            loadText(parser);
+            if (parser.skipBlankLines()) {
+                throw runtime_error("Error: Mismatch between number of teams and team data provided.");
             }
+        }
+    }
 
-            if (triviallyEliminated) {
-                cout << division.getTeamNames()[teamIndex] << " is trivially eliminated." << endl;
-                cout << "Reason: " << eliminationReason << endl;
-                cout << endl;
+    // Reads the next text division from a stream of them (see batch mode);
+    // the caller skips the blank lines in between.
+    explicit Division(StandingsParser& parser) {
+        loadText(parser);
+    }
+
+    static bool isBinaryFile(const string& filename) {
+        return hasBinaryMagic(MappedFile(filename));
+    }
+
+    void writeBinary(const string& filename) const {
+        DivisionFileHeader header;
+        memcpy(header.magic, binaryMagic, sizeof binaryMagic);
+        header.version = binaryVersion;
+        header.numTeams = numTeams;
+        header.numFixtures = 0;
+
+        vector<uint32_t> nameOffsets(numTeams + 1, 0);
+        string nameTable;
+        for (int i = 0; i < numTeams; ++i) {
+            nameTable += teamNames[i];
+            nameOffsets[i + 1] = nameTable.size();
+        }
+        header.nameBytes = nameTable.size();
+        nameTable.resize(alignTo4(nameTable.size()), '\0');
+
+        for (int i = 0; i < numTeams; ++i) {
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                header.numFixtures += schedule.gamesAt(e) > 0;
+            }
+        }
+        size_t numPairs = size_t(numTeams) * (numTeams - 1) / 2;
+        size_t sparseBytes = (numTeams + 1) * sizeof(uint32_t) + header.numFixtures * (sizeof(uint32_t) + sizeof(uint16_t));
+        header.scheduleLayout = numPairs * sizeof(uint16_t) < sparseBytes ? TriangularSchedule : SparseSchedule;
+
+        // The schedule section, walked in (i, j) order
+        vector<uint32_t> fixtureStart;
+        vector<uint32_t> opponents;
+        vector<uint16_t> fixtureGames;
+        if (header.scheduleLayout == SparseSchedule) {
+            fixtureStart.reserve(numTeams + 1);
+            opponents.reserve(header.numFixtures);
+            fixtureGames.reserve(header.numFixtures);
+            for (int i = 0; i < numTeams; ++i) {
+                fixtureStart.push_back(opponents.size());
+                for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                    if (schedule.gamesAt(e) > 0) {
+                        opponents.push_back(schedule.opponentAt(e));
+                        fixtureGames.push_back(schedule.gamesAt(e));
+                    }
+                }
+            }
+            fixtureStart.push_back(opponents.size());
+        } else {
+            fixtureGames.assign(numPairs, 0);
+            size_t rowStart = 0;
+            for (int i = 0; i < numTeams; ++i) {
+                // Pair (i, j) sits at rowStart + (j - i - 1)
+                for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                    fixtureGames[rowStart + schedule.opponentAt(e) - i - 1] = schedule.gamesAt(e);
+                }
+                rowStart += numTeams - i - 1;
+            }
+        }
+        fixtureGames.resize(alignTo4(fixtureGames.size() * sizeof(uint16_t)) / sizeof(uint16_t), 0);
+
+        ofstream out(filename, ios::binary);
+        if (!out) {
+            throw runtime_error("Error: Cannot write file '" + filename + "'.");
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof header);
+        out.write(reinterpret_cast<const char*>(nameOffsets.data()), nameOffsets.size() * sizeof(uint32_t));
+        out.write(nameTable.data(), nameTable.size());
+        for (const vector<long long>* column : {&wins, &losses, &remainingGames}) {
+            out.write(reinterpret_cast<const char*>(column->data()), numTeams * sizeof(int64_t));
+        }
+        out.write(reinterpret_cast<const char*>(fixtureStart.data()), fixtureStart.size() * sizeof(uint32_t));
+        out.write(reinterpret_cast<const char*>(opponents.data()), opponents.size() * sizeof(uint32_t));
+        out.write(reinterpret_cast<const char*>(fixtureGames.data()), fixtureGames.size() * sizeof(uint16_t));
+        if (!out) {
+            throw runtime_error("Error: Failed writing file '" + filename + "'.");
+        }
+    }
+
+    void writeText(ostream& out) const {
+        out << numTeams << "\n";
+        for (int i = 0; i < numTeams; ++i) {
+            out << teamNames[i] << " " << wins[i] << " " << losses[i] << " " << remainingGames[i] << " ";
+            int e = schedule.entryBegin(i);
+            for (int j = 0; j < numTeams; ++j) {
+                bool listed = e < schedule.entryEnd(i) && schedule.opponentAt(e) == j;
+                out << " " << (listed ? schedule.gamesAt(e++) : 0);
+            }
+            out << "\n";
+        }
+    }
+
+    // Getter methods
+    int getNumTeams() const { return numTeams; }
+    const vector<string>& getTeamNames() const { return teamNames; }
+    const vector<long long>& getWins() const { return wins; }
+    const vector<long long>& getLosses() const { return losses; }
+    const vector<long long>& getRemainingGames() const { return remainingGames; }
+    const Schedule& getSchedule() const { return schedule; }
+
+    int getTeamIndex(const string& name) const {
+        auto it = find(teamNames.begin(), teamNames.end(), name);
+        if (it == teamNames.end()) {
+            throw runtime_error("Error: Unknown team '" + name + "'.");
+        }
+        return it - teamNames.begin();
+    }
+
+    // Records that `winner` beat `loser` in one of their remaining games.
+    void recordResult(int winner, int loser) {
+        if (winner < 0 || winner >= numTeams || loser < 0 || loser >= numTeams || winner == loser) {
+            throw runtime_error("Error: Invalid match result.");
+        }
+        if (schedule.gamesBetween(winner, loser) <= 0) {
+            throw runtime_error("Error: No games remain between " + teamNames[winner] + " and " + teamNames[loser] + ".");
+        }
+
+        schedule.playGame(winner, loser);
+        wins[winner]++;
+        losses[loser]++;
+        remainingGames[winner]--;
+        remainingGames[loser]--;
+    }
+};
+
+// -----------------------------
+// Capacity Types
+// -----------------------------
+// Graphs, engines and networks are templated on the capacity type Cap, and
+// each division gets the narrowest type its networks fit in: uint16_t for
+// ordinary leagues, so residuals take half the cache, int32_t beyond that,
+// and int64_t for cumulative standings. An unlimited arc gets the type's
+// largest value. That cannot wrap: an arc's forward and reverse residuals
+// always add up to its capacity, and every finite capacity stays below the
+// infinity. Flow values and totals are long long whatever the type.
+template <typename Cap>
+struct CapacityTraits {
+    static constexpr Cap infinity = numeric_limits<Cap>::max();
+};
+
+enum class CapacityType {
+    UInt16,
+    Int32,
+    Int64
+};
+
+// The largest finite capacity any network of the division can hold: the
+// games left between a pair, or a ceiling minus the fewest wins. Sink arcs
+// and the Teams model's source arcs stay below the latter, including the
+// league-wide network up to the highest ceiling.
+long long largestCapacity(const Division& division) {
+    const auto& wins = division.getWins();
+    const auto& remaining = division.getRemainingGames();
+    const Schedule& schedule = division.getSchedule();
+    long long fewestWins = *min_element(wins.begin(), wins.end());
+    long long largest = 0;
+    for (int i = 0; i < division.getNumTeams(); ++i) {
+        largest = max(largest, wins[i] + remaining[i] - fewestWins);
+        for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+            largest = max<long long>(largest, schedule.gamesAt(e));
+        }
+    }
+    return largest;
+}
+
+CapacityType chooseCapacityType(const Division& division) {
+    long long largest = largestCapacity(division);
+    if (largest < CapacityTraits<uint16_t>::infinity) return CapacityType::UInt16;
+    if (largest < CapacityTraits<int32_t>::infinity) return CapacityType::Int32;
+    return CapacityType::Int64;
+}
+
+const char* capacityTypeName(CapacityType type) {
+    switch (type) {
+        case CapacityType::UInt16: return "uint16";
+        case CapacityType::Int32: return "int32";
+        case CapacityType::Int64:
+        default: return "int64";
+    }
+}
+
+// Calls run(Cap()) with the capacity type chosen for the division and
+// returns what it returns.
+template <typename Run>
+auto withCapacityType(const Division& division, Run run) {
+    switch (chooseCapacityType(division)) {
+        case CapacityType::UInt16: return run(uint16_t());
+        case CapacityType::Int32: return run(int32_t());
+        case CapacityType::Int64:
+        default: return run(int64_t());
+    }
+}
+
+// -----------------------------
+// Graph Class (Compressed Sparse Row)
+// -----------------------------
+// Edges are staged with addEdge() and packed into CSR form by finalize().
+// Every edge becomes a pair of arcs: the forward arc carries the capacity,
+// the reverse arc starts at 0, and getReverseArcs() maps one onto the other.
+template <typename Cap>
+class Graph {
+private:
+    struct PendingEdge {
+        int from;
+        int to;
+        Cap capacity;
+    };
+
+    int numVertices;
+    vector<int> arcStart;       // arcs of vertex v are [arcStart[v], arcStart[v + 1])
+    vector<int> arcHead;
+    vector<Cap> arcCapacity;
+    vector<int> reverseArc;
+    vector<PendingEdge> pendingEdges;
+    vector<int> nextArc;        // finalize() scratch
+
+public:
+    Graph(int vertices) : numVertices(vertices), arcStart(vertices + 1, 0) {}
+
+    // Starts a new graph in the same storage; buffers keep their capacity.
+    void reset(int vertices) {
+        numVertices = vertices;
+        arcStart.assign(vertices + 1, 0);
+        pendingEdges.clear();
+    }
+
+    void addEdge(int from, int to, Cap capacity) {
+        pendingEdges.push_back({from, to, capacity});
+    }
+
+    void finalize() {
+        arcStart.assign(numVertices + 1, 0);
+        for (const auto& e : pendingEdges) {
+            arcStart[e.from + 1]++;
+            arcStart[e.to + 1]++;
+        }
+        for (int v = 0; v < numVertices; ++v) {
+            arcStart[v + 1] += arcStart[v];
+        }
+
+        int numArcs = arcStart[numVertices];
+        arcHead.assign(numArcs, 0);
+        arcCapacity.assign(numArcs, 0);
+        reverseArc.assign(numArcs, 0);
+
+        nextArc.assign(arcStart.begin(), arcStart.end() - 1);
+        for (const auto& e : pendingEdges) {
+            int forward = nextArc[e.from]++;
+            int backward = nextArc[e.to]++;
+            arcHead[forward] = e.to;
+            arcCapacity[forward] = e.capacity;
+            reverseArc[forward] = backward;
+            arcHead[backward] = e.from;
+            arcCapacity[backward] = 0;
+            reverseArc[backward] = forward;
+        }
+
+        pendingEdges.clear();
+    }
+
+    int getNumVertices() const { return numVertices; }
+
+    size_t memoryBytes() const {
+        return (arcStart.capacity() + arcHead.capacity() + reverseArc.capacity() + nextArc.capacity()) * sizeof(int) +
+               arcCapacity.capacity() * sizeof(Cap) + pendingEdges.capacity() * sizeof(PendingEdge);
+    }
+    int getNumArcs() const { return arcStart[numVertices]; }
+    int arcBegin(int v) const { return arcStart[v]; }
+    int arcEnd(int v) const { return arcStart[v + 1]; }
+    const vector<int>& getArcHeads() const { return arcHead; }
+    const vector<Cap>& getArcCapacities() const { return arcCapacity; }
+    const vector<int>& getReverseArcs() const { return reverseArc; }
+
+    void setArcCapacity(int arc, Cap capacity) {
+        arcCapacity[arc] = capacity;
+    }
+};
+
+// -----------------------------
+// Bitset Class
+// -----------------------------
+// Fixed-size set of vertex ids packed 64 to a word.
+class Bitset {
+private:
+    vector<uint64_t> words;
+
+public:
+    // Resizes to `bits` bits, all clear; the storage is reused.
+    void reset(int bits) { words.assign((bits + 63) / 64, 0); }
+
+    bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+    void set(int i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+
+    int numWords() const { return words.size(); }
+    uint64_t& word(int w) { return words[w]; }
+};
+
+// Marks in `visited` every vertex reachable from `root` along arcs with
+// positive residual. The search is level-synchronous over bitset frontiers:
+// each level visits the set bits of the frontier words between the lowest
+// and highest nonzero word and clears them as it goes, so sparse levels stay
+// cheap and both scratch frontiers end up empty.
+template <typename Cap>
+void markResidualReachable(const Graph<Cap>& graph, const vector<Cap>& residual, int root,
+                           Bitset& visited, Bitset& frontier, Bitset& nextFrontier) {
+    int n = graph.getNumVertices();
+    visited.reset(n);
+    frontier.reset(n);
+    nextFrontier.reset(n);
+    visited.set(root);
+    frontier.set(root);
+
+    const auto& heads = graph.getArcHeads();
+    int low = root >> 6, high = root >> 6;
+    while (low <= high) {
+        int nextLow = INT_MAX, nextHigh = -1;
+        for (int w = low; w <= high; ++w) {
+            uint64_t bits = frontier.word(w);
+            frontier.word(w) = 0;
+            while (bits) {
+                int v = (w << 6) + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                for (int a = graph.arcBegin(v); a < graph.arcEnd(v); ++a) {
+                    int u = heads[a];
+                    if (residual[a] > 0 && !visited.test(u)) {
+                        visited.set(u);
+                        nextFrontier.set(u);
+                        nextLow = min(nextLow, u >> 6);
+                        nextHigh = max(nextHigh, u >> 6);
+                    }
+                }
+            }
+        }
+        swap(frontier, nextFrontier);
+        low = nextLow;
+        high = nextHigh;
+    }
+}
+
+// -----------------------------
+// MaxFlowSolver Interface
+// -----------------------------
+// Every engine works on the residual capacities of a finalized Graph (one
+// entry per arc) and leaves a valid maximum flow behind, so callers can read
+// the min cut from getResidualGraph() regardless of the engine used. An engine
+// may start from the residual of an earlier flow instead of the bare
+// capacities; getMaxFlow() then returns only the flow it added on top.
+enum class SolverKind {
+    EdmondsKarp,
+    Dinic,
+    PushRelabel
+};
+
+SolverKind parseSolverKind(const string& name) {
+    if (name == "ek" || name == "edmonds-karp") return SolverKind::EdmondsKarp;
+    if (name == "dinic") return SolverKind::Dinic;
+    if (name == "pr" || name == "push-relabel") return SolverKind::PushRelabel;
+    throw runtime_error("Error: Unknown solver '" + name + "' (expected ek, dinic or push-relabel).");
+}
+
+// How FlowNetwork lays out the games among the other teams.
+//   Pairs: the textbook network, one node per pair with games left:
+//          source -> game (games left) -> both teams (unbounded) -> sink.
+//   Teams: no game nodes. Every game between i < j is first credited to i
+//          (source -> i carries all of i's games against higher teams), and
+//          the arc i -> j (games left) hands any of them over to j. For each
+//          set S of teams a cut costs the games not played inside S plus
+//          the sink capacities of S in both models, so the max flow and the
+//          minimal min cut, and with them the verdict and certificate, agree.
+//   Implicit: the pair network generated from the schedule as it is
+//          searched (see ImplicitFlowNetwork); only the per-team report,
+//          --batch and --bench support it.
+enum class NetworkModel {
+    Pairs,
+    Teams,
+    Implicit
+};
+
+NetworkModel parseNetworkModel(const string& name) {
+    if (name == "pairs") return NetworkModel::Pairs;
+    if (name == "teams") return NetworkModel::Teams;
+    if (name == "implicit") return NetworkModel::Implicit;
+    throw runtime_error("Error: Unknown network model '" + name + "' (expected pairs, teams or implicit).");
+}
+
+// Work done by an engine since the last resetCounters(). They are plain
+// increments on the hot paths and are only read when --stats asks for them.
+struct SolverCounters {
+    long long augmentingPaths = 0;  // Edmonds-Karp and Dinic paths
+    long long phases = 0;           // EK searches, Dinic level graphs, push-relabel global relabels
+    long long pushes = 0;
+    long long relabels = 0;
+    long long arcScans = 0;         // arcs examined by the BFS passes and relabels
+};
+
+template <typename Cap>
+class MaxFlowSolver {
+protected:
+    const Graph<Cap>& graph;
+    int source;
+    int sink;
+    vector<Cap> residual;       // residual capacity per arc
+    vector<int> bfsQueue;       // FIFO scratch: every vertex is enqueued at most once per search
+    SolverCounters counters;
+
+public:
+    MaxFlowSolver(const Graph<Cap>& g, int s, int t, vector<Cap> startResidual)
+        : graph(g), source(s), sink(t), residual(move(startResidual)) {
+        if (residual.empty()) {
+            residual = g.getArcCapacities();
+        }
+    }
+    virtual ~MaxFlowSolver() = default;
+
+    virtual long long getMaxFlow() = 0;
+
+    // Points the engine at a new flow problem on the same Graph object while
+    // keeping its scratch buffers, so a reused engine does not reallocate.
+    void restart(int s, int t, vector<Cap> startResidual) {
+        source = s;
+        sink = t;
+        // Separate branches: one ?: over the const capacities would copy here
+        if (startResidual.empty()) {
+            residual = graph.getArcCapacities();
+        } else {
+            residual = move(startResidual);
+        }
+    }
+
+    const vector<Cap>& getResidualGraph() const {
+        return residual;
+    }
+
+    vector<Cap> releaseResidualGraph() {
+        return move(residual);
+    }
+
+    const SolverCounters& getCounters() const { return counters; }
+    void resetCounters() { counters = SolverCounters(); }
+
+    size_t memoryBytes() const {
+        return residual.capacity() * sizeof(Cap) + bfsQueue.capacity() * sizeof(int);
+    }
+};
+
+// -----------------------------
+// Ford-Fulkerson Class (Edmonds-Karp Algorithm)
+// -----------------------------
+template <typename Cap>
+class FordFulkerson : public MaxFlowSolver<Cap> {
+private:
+    using MaxFlowSolver<Cap>::graph;
+    using MaxFlowSolver<Cap>::source;
+    using MaxFlowSolver<Cap>::sink;
+    using MaxFlowSolver<Cap>::residual;
+    using MaxFlowSolver<Cap>::bfsQueue;
+    using MaxFlowSolver<Cap>::counters;
+
+    vector<int> parentArc;      // arc used to reach each vertex in the last BFS
+
+    bool bfs() {
+        parentArc.assign(graph.getNumVertices(), -1);
+        parentArc[source] = -2;
+        bfsQueue.resize(graph.getNumVertices());
+        int head = 0, tail = 0;
+        bfsQueue[tail++] = source;
+        counters.phases++;
+
+        const auto& heads = graph.getArcHeads();
+        while (head < tail) {
+            int current = bfsQueue[head++];
+            counters.arcScans += graph.arcEnd(current) - graph.arcBegin(current);
+
+            for (int a = graph.arcBegin(current); a < graph.arcEnd(current); ++a) {
+                int next = heads[a];
+                if (parentArc[next] == -1 && residual[a] > 0) {
+                    parentArc[next] = a;
+                    if (next == sink) {
+                        return true;
+                    }
+                    bfsQueue[tail++] = next;
+                }
+            }
+        }
+        return false;
+    }
+
+public:
+    FordFulkerson(const Graph<Cap>& g, int s, int t, vector<Cap> startResidual = {})
+        : MaxFlowSolver<Cap>(g, s, t, move(startResidual)), parentArc(g.getNumVertices(), -1) {}
+
+    long long getMaxFlow() override {
+        long long maxFlow = 0;
+        const auto& heads = graph.getArcHeads();
+        const auto& reverse = graph.getReverseArcs();
+
+        while (bfs()) {
+            // Find bottleneck capacity
+            Cap pathFlow = CapacityTraits<Cap>::infinity;
+            for (int v = sink; v != source; v = heads[reverse[parentArc[v]]]) {
+                pathFlow = min(pathFlow, residual[parentArc[v]]);
+            }
+
+            // Update residual capacities
+            for (int v = sink; v != source; v = heads[reverse[parentArc[v]]]) {
+                int a = parentArc[v];
+                residual[a] -= pathFlow;
+                residual[reverse[a]] += pathFlow;
+            }
+
+            maxFlow += pathFlow;
+            counters.augmentingPaths++;
+        }
+
+        return maxFlow;
+    }
+
+    const vector<int>& getParentArcs() const {
+        return parentArc;
+    }
+};
+
+// -----------------------------
+// Dinic Class (Level Graph + Blocking Flow)
+// -----------------------------
+template <typename Cap>
+class Dinic : public MaxFlowSolver<Cap> {
+private:
+    using MaxFlowSolver<Cap>::graph;
+    using MaxFlowSolver<Cap>::source;
+    using MaxFlowSolver<Cap>::sink;
+    using MaxFlowSolver<Cap>::residual;
+    using MaxFlowSolver<Cap>::bfsQueue;
+    using MaxFlowSolver<Cap>::counters;
+
+    vector<int> level;
+    vector<int> currentArc;     // next arc to try per vertex in the blocking-flow phase
+
+    bool buildLevelGraph() {
+        level.assign(graph.getNumVertices(), -1);
+        level[source] = 0;
+        bfsQueue.resize(graph.getNumVertices());
+        int head = 0, tail = 0;
+        bfsQueue[tail++] = source;
+        counters.phases++;
+
+        const auto& heads = graph.getArcHeads();
+        while (head < tail) {
+            int current = bfsQueue[head++];
+            counters.arcScans += graph.arcEnd(current) - graph.arcBegin(current);
+
+            for (int a = graph.arcBegin(current); a < graph.arcEnd(current); ++a) {
+                int next = heads[a];
+                if (level[next] == -1 && residual[a] > 0) {
+                    level[next] = level[current] + 1;
+                    bfsQueue[tail++] = next;
+                }
+            }
+        }
+        return level[sink] != -1;
+    }
+
+    Cap pushBlockingFlow(int v, Cap limit) {
+        if (v == sink) {
+            return limit;
+        }
+
+        const auto& heads = graph.getArcHeads();
+        const auto& reverse = graph.getReverseArcs();
+        for (int& a = currentArc[v]; a < graph.arcEnd(v); ++a) {
+            int next = heads[a];
+            if (residual[a] > 0 && level[next] == level[v] + 1) {
+                Cap pushed = pushBlockingFlow(next, min(limit, residual[a]));
+                if (pushed > 0) {
+                    residual[a] -= pushed;
+                    residual[reverse[a]] += pushed;
+                    return pushed;
+                }
+            }
+        }
+        return 0;
+    }
+
+public:
+    Dinic(const Graph<Cap>& g, int s, int t, vector<Cap> startResidual = {})
+        : MaxFlowSolver<Cap>(g, s, t, move(startResidual)) {}
+
+    long long getMaxFlow() override {
+        long long maxFlow = 0;
+
+        while (buildLevelGraph()) {
+            currentArc.resize(graph.getNumVertices());
+            for (int v = 0; v < graph.getNumVertices(); ++v) {
+                currentArc[v] = graph.arcBegin(v);
+            }
+
+            while (Cap pushed = pushBlockingFlow(source, CapacityTraits<Cap>::infinity)) {
+                maxFlow += pushed;
+                counters.augmentingPaths++;
+            }
+        }
+
+        return maxFlow;
+    }
+};
+
+// -----------------------------
+// PushRelabel Class (FIFO, Gap + Global Relabel)
+// -----------------------------
+// Heights range over [0, 2n): vertices that can no longer reach the sink are
+// lifted above n and drain their excess back to the source, so the residual
+// left behind is a proper flow and not just a preflow. Excess is long long:
+// the source's and the sink's add up the whole flow.
+template <typename Cap>
+class PushRelabel : public MaxFlowSolver<Cap> {
+private:
+    using MaxFlowSolver<Cap>::graph;
+    using MaxFlowSolver<Cap>::source;
+    using MaxFlowSolver<Cap>::sink;
+    using MaxFlowSolver<Cap>::residual;
+    using MaxFlowSolver<Cap>::bfsQueue;
+    using MaxFlowSolver<Cap>::counters;
+
+    int numVertices;
+    vector<int> height;
+    vector<long long> excess;
+    vector<int> currentArc;
+    vector<int> heightCount;    // number of vertices at each height, for the gap heuristic
+    vector<bool> active;
+    vector<int> activeQueue;    // ring buffer; a vertex is queued at most once at a time
+    int queueHead;
+    int queueSize;
+    int relabelsSinceGlobal;
+
+    void enqueue(int v) {
+        if (v != source && v != sink && !active[v] && excess[v] > 0) {
+            active[v] = true;
+            activeQueue[(queueHead + queueSize++) % numVertices] = v;
+        }
+    }
+
+    void setHeight(int v, int h) {
+        heightCount[height[v]]--;
+        height[v] = h;
+        heightCount[h]++;
+    }
+
+    // Exact distance labels: distance to the sink where it is reachable,
+    // otherwise n plus the distance to the source.
+    void globalRelabel() {
+        const auto& heads = graph.getArcHeads();
+        const auto& reverse = graph.getReverseArcs();
+
+        counters.phases++;
+        height.assign(numVertices, 2 * numVertices - 1);
+        for (int root : {sink, source}) {
+            int base = (root == sink) ? 0 : numVertices;
+            height[root] = base;
+            int head = 0, tail = 0;
+            bfsQueue[tail++] = root;
+            while (head < tail) {
+                int v = bfsQueue[head++];
+                counters.arcScans += graph.arcEnd(v) - graph.arcBegin(v);
+                for (int a = graph.arcBegin(v); a < graph.arcEnd(v); ++a) {
+                    int u = heads[a];
+                    if (height[u] == 2 * numVertices - 1 && u != source && residual[reverse[a]] > 0) {
+                        height[u] = height[v] + 1;
+                        bfsQueue[tail++] = u;
+                    }
+                }
+            }
+        }
+        height[source] = numVertices;
+
+        heightCount.assign(2 * numVertices, 0);
+        for (int v = 0; v < numVertices; ++v) {
+            heightCount[height[v]]++;
+            currentArc[v] = graph.arcBegin(v);
+        }
+        relabelsSinceGlobal = 0;
+    }
+
+    void relabel(int v) {
+        const auto& heads = graph.getArcHeads();
+        int oldHeight = height[v];
+        int newHeight = 2 * numVertices - 1;
+        for (int a = graph.arcBegin(v); a < graph.arcEnd(v); ++a) {
+            if (residual[a] > 0) {
+                newHeight = min(newHeight, height[heads[a]] + 1);
+            }
+        }
+        setHeight(v, newHeight);
+        currentArc[v] = graph.arcBegin(v);
+        relabelsSinceGlobal++;
+        counters.relabels++;
+        counters.arcScans += graph.arcEnd(v) - graph.arcBegin(v);
+
+        // Gap heuristic: nothing above an emptied level below n can reach the sink.
+        if (oldHeight < numVertices && heightCount[oldHeight] == 0) {
+            for (int u = 0; u < numVertices; ++u) {
+                if (u != source && height[u] > oldHeight && height[u] < numVertices) {
+                    setHeight(u, numVertices + 1);
+                    currentArc[u] = graph.arcBegin(u);
+                }
+            }
+        }
+    }
+
+    void discharge(int v) {
+        const auto& heads = graph.getArcHeads();
+        const auto& reverse = graph.getReverseArcs();
+
+        while (excess[v] > 0) {
+            if (currentArc[v] == graph.arcEnd(v)) {
+                relabel(v);
+                continue;
+            }
+
+            int a = currentArc[v];
+            int next = heads[a];
+            if (residual[a] > 0 && height[v] == height[next] + 1) {
+                Cap pushed = static_cast<Cap>(min<long long>(excess[v], residual[a]));
+                residual[a] -= pushed;
+                residual[reverse[a]] += pushed;
+                excess[v] -= pushed;
+                excess[next] += pushed;
+                counters.pushes++;
+                enqueue(next);
+            } else {
+                currentArc[v]++;
+            }
+        }
+    }
+
+public:
+    PushRelabel(const Graph<Cap>& g, int s, int t, vector<Cap> startResidual = {})
+        : MaxFlowSolver<Cap>(g, s, t, move(startResidual)), numVertices(0), queueHead(0), queueSize(0), relabelsSinceGlobal(0) {}
+
+    long long getMaxFlow() override {
+        numVertices = graph.getNumVertices();
+        excess.assign(numVertices, 0);
+        active.assign(numVertices, false);
+        currentArc.assign(numVertices, 0);
+        activeQueue.resize(numVertices);
+        bfsQueue.resize(numVertices);
+        queueHead = 0;
+        queueSize = 0;
+
+        const auto& heads = graph.getArcHeads();
+        const auto& reverse = graph.getReverseArcs();
+        for (int a = graph.arcBegin(source); a < graph.arcEnd(source); ++a) {
+            Cap pushed = residual[a];
+            if (pushed > 0) {
+                residual[a] = 0;
+                residual[reverse[a]] += pushed;
+                excess[heads[a]] += pushed;
+                excess[source] -= pushed;
+                enqueue(heads[a]);
+            }
+        }
+        globalRelabel();
+
+        while (queueSize > 0) {
+            int v = activeQueue[queueHead];
+            queueHead = (queueHead + 1) % numVertices;
+            queueSize--;
+            active[v] = false;
+            discharge(v);
+            if (relabelsSinceGlobal >= numVertices) {
+                globalRelabel();
+            }
+        }
+
+        return excess[sink];
+    }
+};
+
+template <typename Cap>
+unique_ptr<MaxFlowSolver<Cap>> makeSolver(SolverKind kind, const Graph<Cap>& g, int s, int t, vector<Cap> startResidual = {}) {
+    switch (kind) {
+        case SolverKind::Dinic:
+            return make_unique<Dinic<Cap>>(g, s, t, move(startResidual));
+        case SolverKind::PushRelabel:
+            return make_unique<PushRelabel<Cap>>(g, s, t, move(startResidual));
+        case SolverKind::EdmondsKarp:
+        default:
+            return make_unique<FordFulkerson<Cap>>(g, s, t, move(startResidual));
+    }
+}
+
+// -----------------------------
+// EliminationResult Struct
+// -----------------------------
+struct EliminationResult {
+    long long maxFlow = 0;
+    long long totalGames = 0;       // saturation target: capacity leaving the source
+    bool eliminated = false;
+    Bitset sourceSide;              // min-cut side of every vertex
+    vector<int> certificate;        // ids of the teams on the source side of the min cut
+};
+
+// -----------------------------
+// NetworkArena Struct
+// -----------------------------
+// Storage behind a FlowNetwork: the CSR graph, residual, per-team state,
+// reachability frontiers, result and a persistent engine. A worker keeps one
+// arena and builds each team's network in it; buffers are reset rather than
+// freed, so after the first few teams construction and solving do no heap
+// allocation. An arena backs one live network at a time. The implicit*
+// buffers belong to ImplicitFlowNetwork.
+template <typename Cap>
+struct NetworkArena {
+    struct PendingFixture {
+        int team;                   // the lower team of the fixture
+        int entry;                  // the fixture's entry in that team's list
+        Schedule::GameCount games;  // games not yet credited to either side
+    };
+
+    Graph<Cap> graph{1};
+    vector<Cap> residual;
+    vector<long long> wins;
+    vector<long long> remainingGames;
+    Bitset frontier;
+    Bitset nextFrontier;
+    EliminationResult result;
+    unique_ptr<MaxFlowSolver<Cap>> solver;
+    SolverKind solverKind = SolverKind::EdmondsKarp;
+    vector<Schedule::GameCount> implicitCredited;  // per schedule entry: games credited to the list's owner
+    vector<Cap> implicitRoom;                       // per team: wins it can still take below the ceiling
+    vector<int> implicitParentTeam;
+    vector<int> implicitParentEntry;
+    vector<int> implicitOrder;
+    vector<PendingFixture> implicitPending;
+    Bitset implicitReached;
+
+    MaxFlowSolver<Cap>& solverFor(SolverKind kind) {
+        if (!solver || solverKind != kind) {
+            solver = makeSolver(kind, graph, 0, 0);
+            solverKind = kind;
+        }
+        return *solver;
+    }
+};
+
+// -----------------------------
+// FlowNetwork Class
+// -----------------------------
+template <typename Cap>
+class FlowNetwork {
+private:
+    unique_ptr<NetworkArena<Cap>> ownedArena;   // only when the caller supplies no arena
+    NetworkArena<Cap>& arena;
+    Graph<Cap>& graph;
+    int source;
+    int sink;
+    int teamIndex; // Index of the team being analyzed, or -1 for the league-wide network
+    int numTeams;
+    int numGames;
+    int gameNodeStart;
+    int teamNodeStart;
+    const vector<string>& teamNames;
+    vector<long long>& wins;
+    vector<long long>& remainingGames;
+    SolverKind solverKind;
+    NetworkModel model;
+    bool solved;
+    bool analyzed;
+    EliminationResult& result;
+    vector<Cap>& residual;          // residual capacity per arc, kept for warm restarts
+    long long flowValue;
+
+    int adjustedTeamNode(int originalIndex) const {
+        return teamNodeStart + originalIndex - (teamIndex >= 0 && originalIndex > teamIndex ? 1 : 0);
+    }
+
+    // Derives the result from the flow currently held in `residual`.
+    void computeResult() {
+        result.maxFlow = flowValue;
+
+        // Calculate total remaining games (from source)
+        result.totalGames = 0;
+        const auto& capacities = graph.getArcCapacities();
+        for (int a = graph.arcBegin(source); a < graph.arcEnd(source); ++a) {
+            result.totalGames += capacities[a];
+        }
+        result.eliminated = result.maxFlow < result.totalGames;
+
+        // The min-cut source side is everything reachable in the residual graph
+        Bitset& visited = result.sourceSide;
+        markResidualReachable(graph, residual, source, visited, arena.frontier, arena.nextFrontier);
+
+        // Collect team nodes that are reachable from the source
+        result.certificate.clear();
+        for (int i = 0; i < numTeams; ++i) {
+            if (i == teamIndex) continue;
+            if (visited.test(adjustedTeamNode(i))) {
+                result.certificate.push_back(i);
+            }
+        }
+    }
+
+    // Runs the engine from the current residual and adds what it pushes.
+    void augment() {
+        MaxFlowSolver<Cap>& solver = arena.solverFor(solverKind);
+        solver.restart(source, sink, move(residual));
+        flowValue += solver.getMaxFlow();
+        residual = solver.releaseResidualGraph();
+    }
+
+    // Moves one unit of flow along arc a (negative units cancel flow).
+    void shiftFlow(int a, int units) {
+        residual[a] -= units;
+        residual[graph.getReverseArcs()[a]] += units;
+    }
+
+    // Arcs are packed in insertion order: source arcs follow the nodes they
+    // feed (game nodes, or team nodes in the Teams model where gameNodeStart
+    // equals teamNodeStart), and every team node's sink arc comes last.
+    int sourceArcOf(int node) const {
+        return graph.arcBegin(source) + (node - gameNodeStart);
+    }
+
+    int sinkArcOf(int teamNode) const {
+        return graph.arcEnd(teamNode) - 1;
+    }
+
+    int findGameNode(int teamI, int teamJ) const {
+        const auto& heads = graph.getArcHeads();
+        int nodeI = adjustedTeamNode(teamI);
+        int nodeJ = adjustedTeamNode(teamJ);
+        for (int a = graph.arcBegin(nodeI); a < graph.arcEnd(nodeI); ++a) {
+            int gameNode = heads[a];
+            if (gameNode < gameNodeStart || gameNode >= teamNodeStart) continue;
+            for (int b = graph.arcBegin(gameNode); b < graph.arcEnd(gameNode); ++b) {
+                if (heads[b] == nodeJ) {
+                    return gameNode;
+                }
+            }
+        }
+        return -1;
+    }
+
+    // Arc teamI -> teamJ of the Teams model (teamI < teamJ).
+    int findFixtureArc(int teamI, int teamJ) const {
+        const auto& heads = graph.getArcHeads();
+        const auto& capacities = graph.getArcCapacities();
+        int nodeI = adjustedTeamNode(teamI);
+        int nodeJ = adjustedTeamNode(teamJ);
+        for (int a = graph.arcBegin(nodeI); a < graph.arcEnd(nodeI); ++a) {
+            if (heads[a] == nodeJ && capacities[a] > 0) {
+                return a;
+            }
+        }
+        return -1;
+    }
+
+    // Cancels one unit of flow on `arc` together with a flow path through it:
+    // back from its tail to the source and on from its head to the sink. Both
+    // models are acyclic, so the walks always end. A vertex's incoming flow
+    // shows up as positive residual on its reverse arcs (capacity 0), and its
+    // outgoing flow as a forward arc below capacity.
+    void cancelUnitThrough(int arc) {
+        const auto& heads = graph.getArcHeads();
+        const auto& reverse = graph.getReverseArcs();
+        const auto& capacities = graph.getArcCapacities();
+
+        for (int v = heads[reverse[arc]]; v != source;) {
+            int a = graph.arcBegin(v);
+            while (capacities[a] != 0 || residual[a] <= 0) {
+                a++;
+            }
+            shiftFlow(reverse[a], -1);
+            v = heads[a];
+        }
+        for (int v = heads[arc]; v != sink;) {
+            int a = graph.arcBegin(v);
+            while (capacities[a] == 0 || residual[a] >= capacities[a]) {
+                a++;
+            }
+            shiftFlow(a, -1);
+            v = heads[a];
+        }
+        shiftFlow(arc, -1);
+        flowValue--;
+    }
+
+    // Lowers or raises an arc, cancelling any flow above the new capacity.
+    void setCapacity(int arc, Cap capacity) {
+        Cap flow = graph.getArcCapacities()[arc] - residual[arc];
+        for (; flow > capacity; flow--) {
+            cancelUnitThrough(arc);
+        }
+        graph.setArcCapacity(arc, capacity);
+        residual[arc] = capacity - flow;
+    }
+
+    void setSinkCapacities(long long maxPossibleWins) {
+        for (int i = 0; i < numTeams; ++i) {
+            if (i == teamIndex) continue;
+            Cap capacity = static_cast<Cap>(max(0LL, maxPossibleWins - wins[i]));
+            int arc = sinkArcOf(adjustedTeamNode(i));
+            if (capacity != graph.getArcCapacities()[arc]) {
+                setCapacity(arc, capacity);
+            }
+        }
+    }
+
+    // Source and fixture arcs of the Teams model: each team's source arc
+    // (possibly 0) in team order, then one arc per fixture i -> j.
+    void addTeamFixtures(const Schedule& schedule) {
+        for (int i = 0; i < numTeams; ++i) {
+            if (i == teamIndex) continue;
+            long long hosted = 0;
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                if (schedule.opponentAt(e) != teamIndex) {
+                    hosted += schedule.gamesAt(e);
+                }
+            }
+            graph.addEdge(source, adjustedTeamNode(i), static_cast<Cap>(hosted));
+        }
+        for (int i = 0; i < numTeams; ++i) {
+            if (i == teamIndex) continue;
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                int j = schedule.opponentAt(e);
+                if (j != teamIndex && schedule.gamesAt(e) > 0) {
+                    graph.addEdge(adjustedTeamNode(i), adjustedTeamNode(j), schedule.gamesAt(e));
+                }
+            }
+        }
+    }
+
+public:
+    // Builds the network in `sharedArena` when given (resetting whatever it
+    // held before), otherwise in an arena owned by this network. A teamIdx of
+    // -1 builds the league-wide network instead: every team gets a node, every
+    // remaining game is fed from the source, and the ceiling starts at the
+    // most wins any team has (see analyzeWithCeiling()).
+    FlowNetwork(const Division& division, int teamIdx, SolverKind kind = SolverKind::EdmondsKarp,
+                NetworkModel networkModel = NetworkModel::Pairs, NetworkArena<Cap>* sharedArena = nullptr)
+        : ownedArena(sharedArena ? nullptr : make_unique<NetworkArena<Cap>>()),
+          arena(sharedArena ? *sharedArena : *ownedArena),
+          graph(arena.graph),
+          source(0),
+          sink(1),  // Temporary value, will be updated
+          teamIndex(teamIdx),
+          numTeams(division.getNumTeams()),
+          numGames(0),  // Initialize to 0, will calculate in the constructor body
+          gameNodeStart(1),
+          teamNodeStart(1),
+          teamNames(division.getTeamNames()),
+          wins(arena.wins),
+          remainingGames(arena.remainingGames),
+          solverKind(kind),
+          model(networkModel),
+          solved(false),
+          analyzed(false),
+          result(arena.result),
+          residual(arena.residual),
+          flowValue(0)
+    {
+        wins.assign(division.getWins().begin(), division.getWins().end());
+        remainingGames.assign(division.getRemainingGames().begin(), division.getRemainingGames().end());
+
+        // Calculate number of game nodes; only real fixtures are visited
+        const Schedule& schedule = division.getSchedule();
+        for (int i = 0; i < numTeams && model == NetworkModel::Pairs; ++i) {
+            if (i == teamIndex) continue;
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                if (schedule.opponentAt(e) != teamIndex && schedule.gamesAt(e) > 0) {
+                    numGames++;
+                }
+            }
+        }
+
+        // Total nodes = source + game nodes + team nodes + sink
+        int totalNodes = 2 + numGames + numTeams - (teamIndex >= 0 ? 1 : 0);
+        
+        // Properly initialize the graph with the correct number of nodes
+        graph.reset(totalNodes);
+        sink = totalNodes - 1;
+
+        gameNodeStart = 1;
+        teamNodeStart = gameNodeStart + numGames;
+
+        if (model == NetworkModel::Teams) {
+            addTeamFixtures(schedule);
+        }
+
+        // Add edges from source to game nodes and from game nodes to team nodes
+        int gameNode = gameNodeStart;
+        for (int i = 0; i < numTeams && model == NetworkModel::Pairs; ++i) {
+            if (i == teamIndex) continue;
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                int j = schedule.opponentAt(e);
+                if (j == teamIndex) continue;
+                int gamesLeft = schedule.gamesAt(e);
+                if (gamesLeft > 0) {
+                    // Edge from source to game node
+                    graph.addEdge(source, gameNode, gamesLeft);
+
+                    // Edges from game node to team nodes
+                    int teamNodeI = adjustedTeamNode(i);
+                    int teamNodeJ = adjustedTeamNode(j);
+                    graph.addEdge(gameNode, teamNodeI, CapacityTraits<Cap>::infinity);
+                    graph.addEdge(gameNode, teamNodeJ, CapacityTraits<Cap>::infinity);
+
+                    gameNode++;
+                }
+            }
+        }
+
+        // Calculate the maximum number of games Team X can win
+        long long maxPossibleWins = teamIndex >= 0 ? wins[teamIndex] + remainingGames[teamIndex]
+                                                   : *max_element(wins.begin(), wins.end());
+
+        // Add edges from team nodes to sink
+        for (int i = 0; i < numTeams; ++i) {
+            if (i == teamIndex) continue;
+            long long capacity = maxPossibleWins - wins[i];
+            if (capacity < 0) {
+                capacity = 0; // Team already has more wins than Team X can achieve
+            }
+            int teamNode = adjustedTeamNode(i);
+            graph.addEdge(teamNode, sink, static_cast<Cap>(capacity));
+        }
+
+        graph.finalize();
+    }
+
+    // Runs the max-flow engine from the bare capacities. analyze() calls this
+    // itself; it is public so the benchmark can time the solve on its own.
+    void solve() {
+        residual = graph.getArcCapacities();
+        flowValue = 0;
+        arena.solverFor(solverKind).resetCounters();
+        augment();
+        solved = true;
+    }
+
+    int getNumVertices() const { return graph.getNumVertices(); }
+    int getNumArcs() const { return graph.getNumArcs(); }
+
+    // Engine work since the last cold solve; warm repairs add to it.
+    const SolverCounters& getCounters() { return arena.solverFor(solverKind).getCounters(); }
+
+    // Bytes held by the CSR graph, the residual and the engine's scratch.
+    size_t memoryBytes() {
+        return graph.memoryBytes() + residual.capacity() * sizeof(Cap) + arena.solverFor(solverKind).memoryBytes();
+    }
+
+    // Runs the max-flow engine once and derives everything callers need from
+    // that single solve; later calls return the cached result.
+    const EliminationResult& analyze() {
+        if (!analyzed) {
+            if (!solved) {
+                solve();
+            }
+            computeResult();
+            analyzed = true;
+        }
+        return result;
+    }
+
+    // Applies "winner beat loser" to this network and repairs the existing
+    // flow instead of solving from scratch: each capacity that drops cancels
+    // at most the unit(s) of flow now over the limit, then the engine
+    // re-augments from the surviving residual.
+    const EliminationResult& applyResult(int winner, int loser) {
+        analyze();
+
+        wins[winner]++;
+        remainingGames[winner]--;
+        remainingGames[loser]--;
+
+        if (winner != teamIndex && loser != teamIndex) {
+            const auto& capacities = graph.getArcCapacities();
+            if (model == NetworkModel::Teams) {
+                int teamI = min(winner, loser);
+                int sourceArc = sourceArcOf(adjustedTeamNode(teamI));
+                setCapacity(sourceArc, capacities[sourceArc] - 1);
+                int fixtureArc = findFixtureArc(teamI, max(winner, loser));
+                setCapacity(fixtureArc, capacities[fixtureArc] - 1);
+            } else {
+                int arc = sourceArcOf(findGameNode(winner, loser));
+                setCapacity(arc, capacities[arc] - 1);
+            }
+        }
+
+        setSinkCapacities(wins[teamIndex] + remainingGames[teamIndex]);
+        augment();
+        computeResult();
+        return result;
+    }
+
+    // Re-solves as if the team could reach `maxPossibleWins` wins. Raising the
+    // ceiling only adds capacity, so a rising sequence of probes keeps every
+    // unit of flow found so far. The capacity type covers ceilings up to the
+    // highest in the division.
+    const EliminationResult& analyzeWithCeiling(long long maxPossibleWins) {
+        analyze();
+        setSinkCapacities(maxPossibleWins);
+        augment();
+        computeResult();
+        return result;
+    }
+
+    bool isEliminated(bool verbose = false) {
+        const EliminationResult& r = analyze();
+
+        if (verbose) {
+            cout << "Team: " << teamNames[teamIndex] << endl;
+            cout << "Max Flow: " << r.maxFlow << endl;
+            cout << "Total Remaining Games: " << r.totalGames << endl;
+        }
+
+        return r.eliminated;
+    }
+
+    // Team names are only produced here, when a certificate is printed.
+    vector<string> getEliminationCertificate() {
+        vector<string> names;
+        for (int team : analyze().certificate) {
+            names.push_back(teamNames[team]);
+        }
+        return names;
+    }
+};
+
+// -----------------------------
+// ImplicitFlowNetwork Class
+// -----------------------------
+// The pair network without storing it. Its arcs come from the Division's
+// schedule on demand: fixture {i, j} is fed from the source and passes its
+// games to i or j, and a game already credited to one side can be handed
+// back through the fixture to the other. Folding the fixture nodes away
+// leaves a search over teams, where team t reaches opponent u whenever t
+// holds some of their games. The only per-fixture state is how many games
+// each side holds, one 16-bit count per schedule entry. A network therefore
+// costs a third of the schedule it reads, not the tens of bytes per fixture
+// of a built CSR graph, and nothing is constructed per team beyond clearing
+// those counts.
+//
+// A solve starts greedily. Each fixture gives its games to its teams while
+// they have room below the ceiling, and only games that fit nowhere are
+// queued. Augmenting paths from the queued fixtures then shift credited games
+// toward teams with room. The teams the final search reaches are the
+// certificate, the same set the built networks report. The --solver choice
+// does not apply; the capacity type only sizes the per-team room.
+template <typename Cap>
+class ImplicitFlowNetwork {
+private:
+    unique_ptr<NetworkArena<Cap>> ownedArena;   // only when the caller supplies no arena
+    NetworkArena<Cap>& arena;
+    const Schedule& schedule;
+    const vector<long long>& wins;
+    int teamIndex;
+    int numTeams;
+    long long maxPossibleWins;
+    bool solved;
+    bool analyzed;
+    long long flowValue;
+    long long totalGames;
+    EliminationResult& result;
+    SolverCounters counters;
+
+    // Breadth-first search from the queued fixtures' teams; returns a team
+    // with room left, or -1 once none is reachable. parentTeam[u] is the team
+    // u took games from (-1 for a queued fixture), and parentEntry[u] is that
+    // fixture's entry in the parent's list (the queue slot for a fixture).
+    int findPath() {
+        auto& reached = arena.implicitReached;
+        auto& order = arena.implicitOrder;
+        reached.reset(numTeams);
+        order.clear();
+        counters.phases++;
+
+        for (int slot = 0; slot < static_cast<int>(arena.implicitPending.size()); ++slot) {
+            const auto& pending = arena.implicitPending[slot];
+            if (pending.games == 0) continue;
+            for (int team : {pending.team, schedule.opponentAt(pending.entry)}) {
+                if (!reached.test(team)) {
+                    reached.set(team);
+                    arena.implicitParentTeam[team] = -1;
+                    arena.implicitParentEntry[team] = slot;
+                    order.push_back(team);
+                }
+            }
+        }
+        for (size_t head = 0; head < order.size(); ++head) {
+            int team = order[head];
+            if (arena.implicitRoom[team] > 0) {
+                return team;
+            }
+            for (int e = schedule.entryBegin(team); e < schedule.entryEnd(team); ++e) {
+                counters.arcScans++;
+                int opponent = schedule.opponentAt(e);
+                if (arena.implicitCredited[e] > 0 && !reached.test(opponent)) {
+                    reached.set(opponent);
+                    arena.implicitParentTeam[opponent] = team;
+                    arena.implicitParentEntry[opponent] = e;
+                    order.push_back(opponent);
+                }
+            }
+        }
+        return -1;
+    }
+
+    // Pushes the bottleneck along the path ending at `last`.
+    Cap augment(int last) {
+        auto& credited = arena.implicitCredited;
+        auto& parentTeam = arena.implicitParentTeam;
+        auto& parentEntry = arena.implicitParentEntry;
+
+        Cap pathFlow = arena.implicitRoom[last];
+        int team = last;
+        for (; parentTeam[team] >= 0; team = parentTeam[team]) {
+            pathFlow = min(pathFlow, static_cast<Cap>(credited[parentEntry[team]]));
+        }
+        auto& pending = arena.implicitPending[parentEntry[team]];
+        pathFlow = min(pathFlow, static_cast<Cap>(pending.games));
+
+        arena.implicitRoom[last] -= pathFlow;
+        for (team = last; parentTeam[team] >= 0; team = parentTeam[team]) {
+            int from = parentTeam[team];
+            credited[parentEntry[team]] -= pathFlow;
+            credited[schedule.mirrorEntry(from, parentEntry[team])] += pathFlow;
+        }
+        pending.games -= pathFlow;
+        credited[team == pending.team ? pending.entry : schedule.mirrorEntry(pending.team, pending.entry)] += pathFlow;
+        counters.augmentingPaths++;
+        return pathFlow;
+    }
+
+public:
+    // Uses `sharedArena` when given (resetting whatever it held before),
+    // otherwise an arena owned by this network.
+    ImplicitFlowNetwork(const Division& division, int teamIdx, NetworkArena<Cap>* sharedArena = nullptr)
+        : ownedArena(sharedArena ? nullptr : make_unique<NetworkArena<Cap>>()),
+          arena(sharedArena ? *sharedArena : *ownedArena),
+          schedule(division.getSchedule()),
+          wins(division.getWins()),
+          teamIndex(teamIdx),
+          numTeams(division.getNumTeams()),
+          maxPossibleWins(division.getWins()[teamIdx] + division.getRemainingGames()[teamIdx]),
+          solved(false),
+          analyzed(false),
+          flowValue(0),
+          totalGames(0),
+          result(arena.result)
+    {
+        arena.implicitParentTeam.resize(numTeams);
+        arena.implicitParentEntry.resize(numTeams);
+    }
+
+    // Runs the greedy pass and the augmenting paths from scratch. analyze()
+    // calls this itself; it is public so the benchmark can time it alone.
+    void solve() {
+        auto& credited = arena.implicitCredited;
+        auto& room = arena.implicitRoom;
+        credited.assign(schedule.entryEnd(numTeams - 1), 0);
+        room.resize(numTeams);
+        for (int i = 0; i < numTeams; ++i) {
+            room[i] = i == teamIndex ? 0 : static_cast<Cap>(max(0LL, maxPossibleWins - wins[i]));
+        }
+        arena.implicitPending.clear();
+        counters = SolverCounters();
+        flowValue = 0;
+        totalGames = 0;
+
+        for (int i = 0; i < numTeams; ++i) {
+            if (i == teamIndex) continue;
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                int j = schedule.opponentAt(e);
+                int games = schedule.gamesAt(e);
+                if (j == teamIndex || games == 0) continue;
+                int toI = static_cast<int>(min<long long>(games, room[i]));
+                int toJ = static_cast<int>(min<long long>(games - toI, room[j]));
+                room[i] -= toI;
+                room[j] -= toJ;
+                credited[e] = toI;
+                if (toJ > 0) {
+                    credited[schedule.mirrorEntry(i, e)] = toJ;
+                }
+                if (games > toI + toJ) {
+                    arena.implicitPending.push_back({i, e, static_cast<Schedule::GameCount>(games - toI - toJ)});
+                }
+                totalGames += games;
+                flowValue += toI + toJ;
+            }
+        }
+
+        for (int last = findPath(); last >= 0; last = findPath()) {
+            flowValue += augment(last);
+        }
+        solved = true;
+    }
+
+    const EliminationResult& analyze() {
+        if (!analyzed) {
+            if (!solved) {
+                solve();
+            }
+            // The search that found no path reached exactly the source side.
+            result.maxFlow = flowValue;
+            result.totalGames = totalGames;
+            result.eliminated = flowValue < totalGames;
+            result.sourceSide.reset(0);
+            result.certificate.clear();
+            if (result.eliminated) {
+                for (int team = 0; team < numTeams; ++team) {
+                    if (arena.implicitReached.test(team)) {
+                        result.certificate.push_back(team);
+                    }
+                }
+            }
+            analyzed = true;
+        }
+        return result;
+    }
+
+    // Source, the other teams and sink; no arcs are stored.
+    int getNumVertices() const { return numTeams + 1; }
+    int getNumArcs() const { return 0; }
+    const SolverCounters& getCounters() const { return counters; }
+
+    size_t memoryBytes() const {
+        return arena.implicitCredited.capacity() * sizeof(Schedule::GameCount)
+               + arena.implicitRoom.capacity() * sizeof(Cap)
+               + (arena.implicitParentTeam.capacity() + arena.implicitParentEntry.capacity()
+                  + arena.implicitOrder.capacity()) * sizeof(int)
+               + arena.implicitPending.capacity() * sizeof(typename NetworkArena<Cap>::PendingFixture)
+               + arena.implicitReached.numWords() * sizeof(uint64_t);
+    }
+};
+
+// -----------------------------
+// LeagueTracker Class
+// -----------------------------
+// Keeps a live Division with one warm FlowNetwork per contending team and
+// updates them in place as match results arrive. Recording results can only
+// remove possible outcomes, so elimination is permanent and an eliminated
+// team's network is released. Results only shrink capacities, so the
+// capacity type chosen for the initial standings stays wide enough.
+struct TeamStatus {
+    bool eliminated = false;
+    bool trivial = false;           // another team already has more wins than this team's ceiling
+    vector<int> certificate;
+};
+
+class LeagueTracker {
+private:
+    template <typename Cap>
+    using NetworkList = vector<unique_ptr<FlowNetwork<Cap>>>;
+
+    Division division;
+    SolverKind solverKind;
+    variant<NetworkList<uint16_t>, NetworkList<int32_t>, NetworkList<int64_t>> networks;
+    vector<TeamStatus> statuses;
+    int leader = 0;                 // most wins so far, lowest index among ties
+
+    // Re-derives the status of a contending team, releasing its network once
+    // it is eliminated; returns true if the status changed. Wins only grow,
+    // so the running leader tells in O(1) whether any team is out of reach;
+    // the lowest-numbered such team is searched for only then, which happens
+    // once per team since an eliminated team is never updated again.
+    template <typename Cap>
+    bool updateStatus(int teamIndex, NetworkList<Cap>& list) {
+        const EliminationResult& analysis = list[teamIndex]->analyze();
+        TeamStatus updated;
+        const auto& wins = division.getWins();
+        long long maxPossibleWins = wins[teamIndex] + division.getRemainingGames()[teamIndex];
+        if (wins[leader] > maxPossibleWins) {
+            int witness = 0;
+            while (wins[witness] <= maxPossibleWins) {
+                witness++;
+            }
+            updated.eliminated = true;
+            updated.trivial = true;
+            updated.certificate = {witness};
+        }
+        if (!updated.eliminated && analysis.eliminated) {
+            updated.eliminated = true;
+            updated.certificate = analysis.certificate;
+        }
+
+        if (updated.eliminated) {
+            list[teamIndex].reset();
+        }
+        bool changed = updated.eliminated != statuses[teamIndex].eliminated;
+        statuses[teamIndex] = move(updated);
+        return changed;
+    }
+
+public:
+    LeagueTracker(const Division& d, SolverKind kind = SolverKind::EdmondsKarp, NetworkModel model = NetworkModel::Pairs)
+        : division(d), solverKind(kind), statuses(d.getNumTeams()) {
+        const auto& wins = division.getWins();
+        leader = max_element(wins.begin(), wins.end()) - wins.begin();
+        withCapacityType(division, [&](auto cap) {
+            using Cap = decltype(cap);
+            auto& list = networks.emplace<NetworkList<Cap>>(division.getNumTeams());
+            for (int teamIndex = 0; teamIndex < division.getNumTeams(); ++teamIndex) {
+                list[teamIndex] = make_unique<FlowNetwork<Cap>>(division, teamIndex, solverKind, model);
+                updateStatus(teamIndex, list);
+            }
+        });
+    }
+
+    // Records that `winner` beat `loser`, repairs every live network and
+    // returns the teams whose elimination status changed, in team order.
+    vector<int> recordResult(int winner, int loser) {
+        division.recordResult(winner, loser);
+        const auto& wins = division.getWins();
+        if (wins[winner] > wins[leader] || (wins[winner] == wins[leader] && winner < leader)) {
+            leader = winner;
+        }
+
+        vector<int> changed;
+        visit([&](auto& list) {
+            for (int teamIndex = 0; teamIndex < division.getNumTeams(); ++teamIndex) {
+                if (!list[teamIndex]) continue;
+                list[teamIndex]->applyResult(winner, loser);
+                if (updateStatus(teamIndex, list)) {
+                    changed.push_back(teamIndex);
+                }
+            }
+        }, networks);
+        return changed;
+    }
+
+    const Division& getDivision() const { return division; }
+    const TeamStatus& getStatus(int teamIndex) const { return statuses[teamIndex]; }
+};
+
+// -----------------------------
+// Prefix Bound Prefilter
+// -----------------------------
+// A set R of other teams eliminates x when wins(R) plus the games left among
+// R exceed |R| times x's ceiling: R's teams must then average more wins than
+// x can reach. The flow network finds such a set whenever one exists, but
+// the top teams by wins usually suffice. Sorting once and accumulating wins
+// and internal games along that order gives every prefix's bound in
+// O(n log n + m). A team at sorted position p can use any prefix of length
+// k <= p, since those do not contain it, so one running maximum answers every
+// team in O(1). A prefix of length one is the trivial check; teams the
+// prefilter settles never build a network.
+class PrefixBound {
+private:
+    vector<int> order;              // teams by wins, most first, ties by index
+    vector<int> position;           // inverse of order
+    vector<long long> sortedWins;   // wins along order
+    vector<long long> total;        // total[k]: wins of the first k teams plus the games among them
+    vector<int> bestLength;         // bestLength[k]: the k' <= k with the largest total[k'] / k'
+    vector<int> lowestIndex;        // lowestIndex[k]: smallest team index among the first k
+
+public:
+    explicit PrefixBound(const Division& division) {
+        int numTeams = division.getNumTeams();
+        const vector<long long>& wins = division.getWins();
+        const Schedule& schedule = division.getSchedule();
+
+        order.resize(numTeams);
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&](int a, int b) { return wins[a] > wins[b]; });
+        position.resize(numTeams);
+        sortedWins.resize(numTeams);
+        for (int k = 0; k < numTeams; ++k) {
+            position[order[k]] = k;
+            sortedWins[k] = wins[order[k]];
+        }
+
+        total.assign(numTeams + 1, 0);
+        bestLength.assign(numTeams + 1, 0);
+        lowestIndex.assign(numTeams + 1, INT_MAX);
+        for (int k = 1; k <= numTeams; ++k) {
+            int team = order[k - 1];
+            long long added = wins[team];
+            for (int e = schedule.entryBegin(team); e < schedule.entryEnd(team); ++e) {
+                if (position[schedule.opponentAt(e)] < k - 1) {
+                    added += schedule.gamesAt(e);
+                }
+            }
+            total[k] = total[k - 1] + added;
+            // Cross-multiplied in 128 bits: totals of 64-bit wins times a length can pass 2^63
+            int best = bestLength[k - 1];
+            bestLength[k] = best == 0 || __int128(total[k]) * best > __int128(total[best]) * k ? k : best;
+            lowestIndex[k] = min(lowestIndex[k - 1], team);
+        }
+    }
+
+    // The lowest-numbered team that already has more wins than `ceiling`, or -1.
+    int trivialWitness(long long ceiling) const {
+        int above = partition_point(sortedWins.begin(), sortedWins.end(), [&](long long w) { return w > ceiling; })
+                    - sortedWins.begin();
+        return above > 0 ? lowestIndex[above] : -1;
+    }
+
+    // The length of a prefix that eliminates `team` with the given ceiling, or 0.
+    int eliminatingPrefix(int team, long long ceiling) const {
+        int length = bestLength[position[team]];
+        return length > 0 && total[length] > __int128(ceiling) * length ? length : 0;
+    }
+
+    // The first `length` teams of the order, by team index.
+    vector<int> prefixTeams(int length) const {
+        vector<int> teams(order.begin(), order.begin() + length);
+        sort(teams.begin(), teams.end());
+        return teams;
+    }
+};
+
+// -----------------------------
+// Small League Solver
+// -----------------------------
+// Most divisions have a handful of teams, and for them building a CSR
+// network costs more than solving it. SmallLeagueSolver<N> takes any league
+// of at most N teams and fixes the pair network's layout at compile time:
+// one node per unordered pair, one per team, then the sink and the source.
+// Arcs are implicit. A pair node reaches both of its teams without limit, so
+// only the source arcs, the flow on each pair-to-team arc and the sink arcs
+// are stored, all in std::arrays sized by N. A solve allocates nothing, and
+// the loops have fixed trip counts the compiler can unroll. Edmonds-Karp
+// augments until no path is left. The teams the last search reaches are the
+// certificate, the same set every other engine reports.
+struct SmallLeagueResult {
+    long long maxFlow = 0;
+    long long totalGames = 0;
+    bool eliminated = false;
+    uint64_t certificate = 0;       // bit t set when team t is in the certificate
+};
+
+template <int N>
+class SmallLeagueSolver {
+    static_assert(N >= 2 && N <= 64, "certificates are 64-bit masks");
+
+public:
+    static constexpr int numPairs = N * (N - 1) / 2;
+
+private:
+    static constexpr int sinkNode = numPairs + N;
+    static constexpr int sourceNode = numPairs + N + 1;
+    static constexpr int numNodes = numPairs + N + 2;
+
+    // Pair node of {i, j} and the two teams of each pair node.
+    struct Layout {
+        array<array<int, N>, N> pairOf{};
+        array<array<int, 2>, numPairs> teamsOf{};
+    };
+
+    static constexpr Layout makeLayout() {
+        Layout layout{};
+        int pair = 0;
+        for (int i = 0; i < N; ++i) {
+            for (int j = i + 1; j < N; ++j) {
+                layout.pairOf[i][j] = layout.pairOf[j][i] = pair;
+                layout.teamsOf[pair][0] = i;
+                layout.teamsOf[pair][1] = j;
+                ++pair;
+            }
+        }
+        return layout;
+    }
+
+    static constexpr Layout layout = makeLayout();
+
+    array<int, numPairs> sourceResidual{};      // games between the pair not yet routed
+    array<array<int, 2>, numPairs> pairFlow{};  // flow from the pair node to each of its teams
+    array<long long, N> sinkResidual{};         // wins each team can still absorb
+    array<int, numNodes> parent;
+    array<int, numNodes> pending;     // BFS queue
+    array<bool, numNodes> visited;
+
+    // Breadth-first search from the source; true when it reaches the sink.
+    bool findPath() {
+        visited.fill(false);
+        int head = 0, tail = 0;
+        for (int pair = 0; pair < numPairs; ++pair) {
+            if (sourceResidual[pair] > 0) {
+                visited[pair] = true;
+                parent[pair] = sourceNode;
+                pending[tail++] = pair;
+            }
+        }
+        while (head < tail) {
+            int node = pending[head++];
+            if (node < numPairs) {
+                for (int side = 0; side < 2; ++side) {
+                    int teamNode = numPairs + layout.teamsOf[node][side];
+                    if (!visited[teamNode]) {
+                        visited[teamNode] = true;
+                        parent[teamNode] = node;
+                        pending[tail++] = teamNode;
+                    }
+                }
+            } else {
+                int team = node - numPairs;
+                if (sinkResidual[team] > 0) {
+                    parent[sinkNode] = node;
+                    return true;
+                }
+                // Undo flow that reached this team through another pair
+                for (int other = 0; other < N; ++other) {
+                    if (other == team) continue;
+                    int pair = layout.pairOf[team][other];
+                    if (!visited[pair] && pairFlow[pair][team > other] > 0) {
+                        visited[pair] = true;
+                        parent[pair] = node;
+                        pending[tail++] = pair;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // The bottleneck is at most one pair's games, so it fits in an int.
+    int augment() {
+        long long sinkRoom = sinkResidual[parent[sinkNode] - numPairs];
+        int pathFlow = static_cast<int>(min<long long>(sinkRoom, Schedule::maxGamesPerPair));
+        for (int node = parent[sinkNode]; node != sourceNode; node = parent[node]) {
+            int from = parent[node];
+            if (from == sourceNode) {
+                pathFlow = min(pathFlow, sourceResidual[node]);
+            } else if (node < numPairs) {
+                pathFlow = min(pathFlow, pairFlow[node][from - numPairs > layout.teamsOf[node][0]]);
+            }
+        }
+        sinkResidual[parent[sinkNode] - numPairs] -= pathFlow;
+        for (int node = parent[sinkNode]; node != sourceNode; node = parent[node]) {
+            int from = parent[node];
+            if (from == sourceNode) {
+                sourceResidual[node] -= pathFlow;
+            } else if (node < numPairs) {
+                pairFlow[node][from - numPairs > layout.teamsOf[node][0]] -= pathFlow;
+            } else {
+                pairFlow[from][node - numPairs > layout.teamsOf[from][0]] += pathFlow;
+            }
+        }
+        return pathFlow;
+    }
+
+public:
+    SmallLeagueResult solve(const Division& division, int teamIndex) {
+        const Schedule& schedule = division.getSchedule();
+        const vector<long long>& wins = division.getWins();
+        long long maxPossibleWins = wins[teamIndex] + division.getRemainingGames()[teamIndex];
+        SmallLeagueResult result;
+
+        sourceResidual.fill(0);
+        for (auto& flow : pairFlow) {
+            flow = {0, 0};
+        }
+        sinkResidual.fill(0);
+        for (int i = 0; i < division.getNumTeams(); ++i) {
+            if (i == teamIndex) continue;
+            sinkResidual[i] = max(0LL, maxPossibleWins - wins[i]);
+            for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+                int j = schedule.opponentAt(e);
+                if (j == teamIndex) continue;
+                sourceResidual[layout.pairOf[i][j]] = schedule.gamesAt(e);
+                result.totalGames += schedule.gamesAt(e);
+            }
+        }
+
+        while (findPath()) {
+            result.maxFlow += augment();
+        }
+        result.eliminated = result.maxFlow < result.totalGames;
+        if (result.eliminated) {
+            for (int team = 0; team < N; ++team) {
+                if (visited[numPairs + team]) {
+                    result.certificate |= uint64_t(1) << team;
+                }
+            }
+        }
+        return result;
+    }
+};
+
+// Largest league the fixed-size solvers take.
+constexpr int smallLeagueMaxTeams = 16;
+
+// Solves with the smallest SmallLeagueSolver the league fits in; returns
+// false, leaving `result` alone, when it has more than smallLeagueMaxTeams teams.
+bool solveSmallLeague(const Division& division, int teamIndex, SmallLeagueResult& result) {
+    int numTeams = division.getNumTeams();
+    if (numTeams <= 8) {
+        SmallLeagueSolver<8> solver;
+        result = solver.solve(division, teamIndex);
+        return true;
+    }
+    if (numTeams <= smallLeagueMaxTeams) {
+        SmallLeagueSolver<smallLeagueMaxTeams> solver;
+        result = solver.solve(division, teamIndex);
+        return true;
+    }
+    return false;
+}
+
+// -----------------------------
+// Team Report
+// -----------------------------
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Per-team numbers for --stats. Teams settled by the prefix bound never
+// build a network, so only their verdict is filled in.
+struct TeamStats {
+    bool trivial = false;
+    bool prefiltered = false;       // eliminated by a prefix of two or more teams
+    bool eliminated = false;
+    int nodes = 0;
+    int arcs = 0;
+    long long maxFlow = 0;
+    long long totalGames = 0;
+    double buildMs = 0;
+    double solveMs = 0;
+    double certificateMs = 0;
+    SolverCounters counters;
+    size_t residualBytes = 0;
+    long long allocations = 0;      // heap allocations while building, solving and extracting
+};
+
+// Builds a network with `build`, solves it and returns the verdict, filling
+// `stats` when given. Serves FlowNetwork and ImplicitFlowNetwork alike.
+template <typename Build>
+TeamStatus solveNetwork(Build build, TeamStats* stats) {
+    long long allocationsBefore = threadAllocations;
+    chrono::steady_clock::time_point start;
+    if (stats) {
+        start = chrono::steady_clock::now();
+    }
+    auto fn = build();
+    if (stats) {
+        stats->buildMs = millisecondsSince(start);
+        start = chrono::steady_clock::now();
+        fn.solve();
+        stats->solveMs = millisecondsSince(start);
+        start = chrono::steady_clock::now();
+    }
+    const EliminationResult& analysis = fn.analyze();
+    if (stats) {
+        stats->certificateMs = millisecondsSince(start);
+        stats->allocations = threadAllocations - allocationsBefore;
+        stats->eliminated = analysis.eliminated;
+        stats->nodes = fn.getNumVertices();
+        stats->arcs = fn.getNumArcs();
+        stats->maxFlow = analysis.maxFlow;
+        stats->totalGames = analysis.totalGames;
+        stats->counters = fn.getCounters();
+        stats->residualBytes = fn.memoryBytes();
+    }
+    TeamStatus status;
+    status.eliminated = analysis.eliminated;
+    if (analysis.eliminated) {
+        status.certificate = analysis.certificate;
+    }
+    return status;
+}
+
+// Settles one team: the prefix bound first (which covers the trivial
+// check), then a SmallLeagueSolver or a flow network. With `stats` null
+// (the usual case) nothing is timed or counted, and leagues small enough
+// for a SmallLeagueSolver skip the general network entirely.
+template <typename Cap>
+TeamStatus analyzeTeam(const Division& division, const PrefixBound& bound, int teamIndex, SolverKind solverKind,
+                       NetworkModel model, NetworkArena<Cap>& arena, TeamStats* stats = nullptr) {
+    // Trivial elimination check
+    long long maxPossibleWins = division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex];
+    int witness = bound.trivialWitness(maxPossibleWins);
+    int prefixLength = witness < 0 ? bound.eliminatingPrefix(teamIndex, maxPossibleWins) : 0;
+    TeamStatus status;
+
+    if (witness >= 0) {
+        if (stats) {
+            stats->trivial = stats->eliminated = true;
+        }
+        status.eliminated = status.trivial = true;
+        status.certificate = {witness};
+    } else if (prefixLength > 0) {
+        if (stats) {
+            stats->prefiltered = stats->eliminated = true;
+        }
+        status.eliminated = true;
+        status.certificate = bound.prefixTeams(prefixLength);
+    } else if (SmallLeagueResult small; !stats && solveSmallLeague(division, teamIndex, small)) {
+        status.eliminated = small.eliminated;
+        for (uint64_t bits = small.certificate; bits; bits &= bits - 1) {
+            status.certificate.push_back(__builtin_ctzll(bits));
+        }
+    } else if (model == NetworkModel::Implicit) {
+        status = solveNetwork([&] { return ImplicitFlowNetwork<Cap>(division, teamIndex, &arena); }, stats);
+    } else {
+        // Non-trivial elimination check using Flow Network
+        status = solveNetwork([&] { return FlowNetwork<Cap>(division, teamIndex, solverKind, model, &arena); }, stats);
+    }
+    return status;
+}
+
+// -----------------------------
+// Elimination Pass
+// -----------------------------
+// Every team's FlowNetwork is independent, so workers claim team indices from
+// a shared counter and store each verdict in its team's slot; the caller
+// writes them in team order, which keeps the output identical to a serial
+// run. Each worker builds all of its networks in one NetworkArena of the
+// division's capacity type; the prefix bound is shared.
+vector<TeamStatus> analyzeDivision(const Division& division, SolverKind solverKind, NetworkModel model, int numThreads,
+                                   vector<TeamStats>* stats = nullptr) {
+    int numTeams = division.getNumTeams();
+    vector<TeamStatus> statuses(numTeams);
+    atomic<int> nextTeam(0);
+    if (stats) {
+        stats->assign(numTeams, TeamStats());
+    }
+    PrefixBound bound(division);
+
+    withCapacityType(division, [&](auto cap) {
+        auto worker = [&]() {
+            NetworkArena<decltype(cap)> arena;
+            for (int teamIndex = nextTeam++; teamIndex < numTeams; teamIndex = nextTeam++) {
+                statuses[teamIndex] = analyzeTeam(division, bound, teamIndex, solverKind, model, arena,
+                                                  stats ? &(*stats)[teamIndex] : nullptr);
+            }
+        };
+
+        vector<thread> pool;
+        for (int t = 1; t < min(numThreads, numTeams); ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& t : pool) {
+            t.join();
+        }
+    });
+
+    return statuses;
+}
+
+// -----------------------------
+// Report Writer
+// -----------------------------
+// Formats team verdicts into one large buffer and hands it to the stream in
+// big writes: whenever it passes flushThreshold, and at finish(), which
+// also flushes the stream. Numbers go through to_chars and nothing calls
+// endl, so writing stays a small share of the run on big leagues.
+//   Text: the prose reports.
+//   JSON Lines: one object per team with its id (0-based input order),
+//        name, status, max_wins (the ceiling), certificate ids, and
+//        average_bound. average_bound is the certificate's wins plus the
+//        games left among it, divided by its size. It exceeds max_wins
+//        exactly when the certificate proves elimination.
+//   CSV: the same fields under a header row; certificate ids are separated
+//        by spaces.
+// A labelled writer (--batch) adds the division label: a "=== label ==="
+// line in text, and a "division" field or leading column otherwise.
+enum class OutputFormat {
+    Text,
+    JsonLines,
+    Csv
+};
+
+OutputFormat parseOutputFormat(const string& name) {
+    if (name == "text") return OutputFormat::Text;
+    if (name == "jsonl") return OutputFormat::JsonLines;
+    if (name == "csv") return OutputFormat::Csv;
+    throw runtime_error("Error: Unknown output format '" + name + "' (expected text, jsonl or csv).");
+}
+
+// Appends `text` as a quoted JSON string.
+void appendJsonString(string& out, const string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof escape, "\\u%04x", c);
+            out += escape;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+string jsonString(const string& text) {
+    string quoted;
+    appendJsonString(quoted, text);
+    return quoted;
+}
+
+// Appends the prose verdict for one team, blank line included. The text
+// report, --stream and --serve all word their verdicts through this.
+void appendStatusText(string& out, const Division& division, int teamIndex, const TeamStatus& status) {
+    const auto& names = division.getTeamNames();
+    out += names[teamIndex];
+    if (status.trivial) {
+        out += " is trivially eliminated.\nReason: ";
+        out += names[status.certificate.front()];
+        out += " already has more wins than ";
+        out += names[teamIndex];
+        out += " can achieve.\n\n";
+    } else if (status.eliminated) {
+        out += " is eliminated.\nThey are eliminated by the subset { ";
+        for (int team : status.certificate) {
+            out += names[team];
+            out += ' ';
+        }
+        out += "}.\n\n";
+    } else {
+        out += " is not eliminated.\n\n";
+    }
+}
+
+class ReportWriter {
+private:
+    static constexpr size_t flushThreshold = 1 << 20;
+
+    ostream& out;
+    OutputFormat format;
+    bool labelled;
+    string buffer;
+    string label;
+    Bitset members;                 // scratch for the certificate's internal games
+
+    void append(const string& text) { buffer += text; }
+    void append(const char* text) { buffer += text; }
+    void append(char c) { buffer += c; }
+
+    void appendNumber(long long value) {
+        char digits[24];
+        buffer.append(digits, to_chars(digits, digits + sizeof digits, value).ptr);
+    }
+
+    void appendNumber(double value) {
+        char digits[32];
+        buffer.append(digits, to_chars(digits, digits + sizeof digits, value).ptr);
+    }
+
+    void appendCsvField(const string& text) {
+        if (text.find_first_of(",\"\r\n") == string::npos) {
+            buffer += text;
+            return;
+        }
+        buffer += '"';
+        for (char c : text) {
+            if (c == '"') buffer += '"';
+            buffer += c;
+        }
+        buffer += '"';
+    }
+
+    // (wins of the certificate + games left among its teams) / its size.
+    double averageBound(const Division& division, const vector<int>& certificate) {
+        const Schedule& schedule = division.getSchedule();
+        members.reset(division.getNumTeams());
+        for (int team : certificate) {
+            members.set(team);
+        }
+        long long total = 0;
+        for (int team : certificate) {
+            total += division.getWins()[team];
+            for (int e = schedule.upperEntryBegin(team); e < schedule.entryEnd(team); ++e) {
+                if (members.test(schedule.opponentAt(e))) {
+                    total += schedule.gamesAt(e);
+                }
+            }
+        }
+        return double(total) / certificate.size();
+    }
+
+    const char* statusName(const TeamStatus& status) const {
+        return status.trivial ? "trivially_eliminated" : status.eliminated ? "eliminated" : "not_eliminated";
+    }
+
+    void writeJson(const Division& division, int teamIndex, const TeamStatus& status) {
+        append('{');
+        if (labelled) {
+            append("\"division\": ");
+            appendJsonString(buffer, label);
+            append(", ");
+        }
+        append("\"id\": ");
+        appendNumber(static_cast<long long>(teamIndex));
+        append(", \"team\": ");
+        appendJsonString(buffer, division.getTeamNames()[teamIndex]);
+        append(", \"status\": \"");
+        append(statusName(status));
+        append("\", \"max_wins\": ");
+        appendNumber(static_cast<long long>(division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex]));
+        append(", \"certificate\": [");
+        for (size_t k = 0; k < status.certificate.size(); ++k) {
+            if (k) append(", ");
+            appendNumber(static_cast<long long>(status.certificate[k]));
+        }
+        append("], \"average_bound\": ");
+        if (status.eliminated) {
+            appendNumber(averageBound(division, status.certificate));
+        } else {
+            append("null");
+        }
+        append("}\n");
+    }
+
+    void writeCsv(const Division& division, int teamIndex, const TeamStatus& status) {
+        if (labelled) {
+            appendCsvField(label);
+            append(',');
+        }
+        appendNumber(static_cast<long long>(teamIndex));
+        append(',');
+        appendCsvField(division.getTeamNames()[teamIndex]);
+        append(',');
+        append(statusName(status));
+        append(',');
+        appendNumber(static_cast<long long>(division.getWins()[teamIndex] + division.getRemainingGames()[teamIndex]));
+        append(',');
+        for (size_t k = 0; k < status.certificate.size(); ++k) {
+            if (k) append(' ');
+            appendNumber(static_cast<long long>(status.certificate[k]));
+        }
+        append(',');
+        if (status.eliminated) {
+            appendNumber(averageBound(division, status.certificate));
+        }
+        append('\n');
+    }
+
+    void writeBuffer() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+public:
+    ReportWriter(ostream& stream, OutputFormat outputFormat, bool withLabels = false)
+        : out(stream), format(outputFormat), labelled(withLabels) {
+        buffer.reserve(flushThreshold + flushThreshold / 4);
+        if (format == OutputFormat::Csv) {
+            append(labelled ? "division,id,team,status,max_wins,certificate,average_bound\n"
+                            : "id,team,status,max_wins,certificate,average_bound\n");
+        }
+    }
+
+    // Starts the next division of a labelled writer.
+    void beginDivision(const string& divisionLabel) {
+        label = divisionLabel;
+        if (format == OutputFormat::Text) {
+            append("=== ");
+            append(label);
+            append(" ===\n");
+        }
+    }
+
+    void writeTeam(const Division& division, int teamIndex, const TeamStatus& status) {
+        switch (format) {
+            case OutputFormat::Text: appendStatusText(buffer, division, teamIndex, status); break;
+            case OutputFormat::JsonLines: writeJson(division, teamIndex, status); break;
+            case OutputFormat::Csv: writeCsv(division, teamIndex, status); break;
+        }
+        if (buffer.size() >= flushThreshold) {
+            writeBuffer();
+        }
+    }
+
+    void writeDivision(const Division& division, const vector<TeamStatus>& statuses) {
+        for (int teamIndex = 0; teamIndex < division.getNumTeams(); ++teamIndex) {
+            writeTeam(division, teamIndex, statuses[teamIndex]);
+        }
+    }
+
+    void finish() {
+        writeBuffer();
+        out.flush();
+    }
+};
+
+// -----------------------------
+// Threshold Search
+// -----------------------------
+// Elimination is monotone in a team's ceiling (wins + remaining games): if a
+// team with ceiling c survives, so does every team whose ceiling is at least
+// c. Binary searching the distinct ceilings therefore settles the whole
+// league with O(log n) flow solves instead of one per team.
+struct ThresholdResult {
+    long long threshold = 0;        // smallest ceiling that still survives
+    int flowSolves = 0;
+    vector<bool> eliminated;        // per team
+    vector<int> eliminatedBoundary; // teams on the highest eliminated ceiling
+    vector<int> aliveBoundary;      // teams on the lowest surviving ceiling
+};
+
+ThresholdResult findEliminationThreshold(const Division& division, SolverKind solverKind, NetworkModel model) {
+    int numTeams = division.getNumTeams();
+    const auto& wins = division.getWins();
+    const auto& remaining = division.getRemainingGames();
+
+    vector<long long> ceilings(numTeams);
+    vector<int> order(numTeams);
+    for (int i = 0; i < numTeams; ++i) {
+        ceilings[i] = wins[i] + remaining[i];
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&](int a, int b) { return ceilings[a] < ceilings[b]; });
+
+    // One representative team per distinct ceiling, in ascending order
+    vector<int> representatives;
+    for (int team : order) {
+        if (representatives.empty() || ceilings[representatives.back()] != ceilings[team]) {
+            representatives.push_back(team);
+        }
+    }
+
+    // The top ceiling always survives: some team finishes first in every outcome.
+    ThresholdResult result;
+    long long maxWins = *max_element(wins.begin(), wins.end());
+    int lo = 0, hi = representatives.size() - 1;
+    withCapacityType(division, [&](auto cap) {
+        NetworkArena<decltype(cap)> arena;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            int team = representatives[mid];
+            bool eliminated = maxWins > ceilings[team];
+            if (!eliminated) {
+                FlowNetwork<decltype(cap)> fn(division, team, solverKind, model, &arena);
+                eliminated = fn.analyze().eliminated;
+                result.flowSolves++;
+            }
+            if (eliminated) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+    });
+
+    result.threshold = ceilings[representatives[lo]];
+    result.eliminated.assign(numTeams, false);
+    for (int team : order) {
+        result.eliminated[team] = ceilings[team] < result.threshold;
+        if (ceilings[team] == result.threshold) {
+            result.aliveBoundary.push_back(team);
+        } else if (lo > 0 && ceilings[team] == ceilings[representatives[lo - 1]]) {
+            result.eliminatedBoundary.push_back(team);
+        }
+    }
+    sort(result.aliveBoundary.begin(), result.aliveBoundary.end());
+    sort(result.eliminatedBoundary.begin(), result.eliminatedBoundary.end());
+    return result;
+}
+
+void writeThresholdReport(const Division& division, const ThresholdResult& result, ostream& out) {
+    const auto& names = division.getTeamNames();
+    out << "Elimination threshold: " << result.threshold << " possible wins ("
+        << result.flowSolves << " flow solves)." << endl;
+    if (!result.eliminatedBoundary.empty()) {
+        out << "Boundary (eliminated): { ";
+        for (int team : result.eliminatedBoundary) {
+            out << names[team] << " ";
+        }
+        out << "}." << endl;
+    }
+    out << "Boundary (alive): { ";
+    for (int team : result.aliveBoundary) {
+        out << names[team] << " ";
+    }
+    out << "}." << endl;
+    out << endl;
+
+    for (int team = 0; team < division.getNumTeams(); ++team) {
+        out << names[team] << (result.eliminated[team] ? " is eliminated." : " is not eliminated.") << endl;
+    }
+}
+
+// -----------------------------
+// Elimination Numbers
+// -----------------------------
+// Each of a team's losses lowers its ceiling and is a win for the opponent,
+// so after k more losses the team survives only if some outcome of all the
+// remaining games, its own included, leaves every team at or below its
+// ceiling minus k. Whether such an outcome exists depends only on that
+// bound, not on the team: it is the league-wide network with every team's
+// sink capacity set to the bound. The smallest bound that fits is the lowest
+// winning total the league can still produce, found by raising the ceiling
+// of one warm league-wide FlowNetwork from a lower bound. A team's
+// elimination number is its ceiling minus that total, capped at its
+// remaining games. It is a best case: the team survives that many losses
+// only if they and the other games fall the right way, and fewer losses to
+// the wrong opponents can already eliminate it. One more loss than that
+// eliminates it whichever games it loses. The magic number is the classic
+// count of own wins plus rival losses needed to finish strictly ahead of
+// every rival's ceiling.
+struct TeamNumbers {
+    long long ceiling = 0;          // wins + remaining games
+    long long eliminationNumber = 0;  // most losses it may survive; negative when already eliminated
+    long long magicNumber = 0;
+};
+
+struct EliminationNumbers {
+    long long lowestWinningTotal = 0;  // smallest total some outcome holds every team to
+    vector<TeamNumbers> teams;
+};
+
+EliminationNumbers computeEliminationNumbers(const Division& division, SolverKind solverKind, NetworkModel model) {
+    int numTeams = division.getNumTeams();
+    const auto& wins = division.getWins();
+    const auto& remaining = division.getRemainingGames();
+    const Schedule& schedule = division.getSchedule();
+
+    long long totalWins = accumulate(wins.begin(), wins.end(), 0LL);
+    long long totalGames = 0;
+    for (int i = 0; i < numTeams; ++i) {
+        for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+            totalGames += schedule.gamesAt(e);
+        }
+    }
+
+    // Lower bound: no team can lose wins it already has, and every game
+    // goes to someone, so the winning total is at least the average.
+    long long maxWins = *max_element(wins.begin(), wins.end());
+    long long averageBound = (totalWins + totalGames + numTeams - 1) / numTeams;
+    long long probe = max(maxWins, averageBound);
+
+    // A failed probe's certificate R holds more wins plus games among
+    // themselves than |R| teams can share below the probe, so no total under
+    // ceil((w(R) + g(R)) / |R|) fits. Jumping there is a Newton step: each
+    // jump settles one cut, so the search takes a handful of solves rather
+    // than one per win.
+    vector<char> inCut(numTeams, 0);
+    withCapacityType(division, [&](auto cap) {
+        FlowNetwork<decltype(cap)> league(division, -1, solverKind, model);
+        for (;;) {
+            const EliminationResult& r = league.analyzeWithCeiling(probe);
+            if (!r.eliminated) {
+                break;
+            }
+
+            long long cutTotal = 0;
+            for (int t : r.certificate) {
+                inCut[t] = 1;
+            }
+            for (int t : r.certificate) {
+                cutTotal += wins[t];
+                for (int e = schedule.upperEntryBegin(t); e < schedule.entryEnd(t); ++e) {
+                    if (inCut[schedule.opponentAt(e)]) {
+                        cutTotal += schedule.gamesAt(e);
+                    }
+                }
+            }
+            for (int t : r.certificate) {
+                inCut[t] = 0;
+            }
+
+            long long cutSize = static_cast<long long>(r.certificate.size());
+            long long cutBound = cutSize ? (cutTotal + cutSize - 1) / cutSize : probe + 1;
+            probe = max(probe + 1, cutBound);
+        }
+    });
+
+    EliminationNumbers numbers;
+    numbers.lowestWinningTotal = probe;
+    numbers.teams.resize(numTeams);
+    for (int x = 0; x < numTeams; ++x) {
+        long long maxOtherCeiling = 0;
+        for (int i = 0; i < numTeams; ++i) {
+            if (i != x) {
+                maxOtherCeiling = max(maxOtherCeiling, wins[i] + remaining[i]);
+            }
+        }
+
+        TeamNumbers& n = numbers.teams[x];
+        n.ceiling = wins[x] + remaining[x];
+        n.eliminationNumber = min(n.ceiling - probe, remaining[x]);
+        n.magicNumber = max(0LL, maxOtherCeiling - wins[x] + 1);
+    }
+    return numbers;
+}
+
+void writeEliminationNumbers(const Division& division, const EliminationNumbers& numbers, ostream& out) {
+    const auto& names = division.getTeamNames();
+    size_t nameWidth = 4;
+    for (const auto& name : names) {
+        nameWidth = max(nameWidth, name.size());
+    }
+    size_t ceilingWidth = 9;
+    for (const TeamNumbers& n : numbers.teams) {
+        ceilingWidth = max(ceilingWidth, to_string(n.ceiling).size() + 2);
+    }
+
+    out << "Lowest winning total still possible: " << numbers.lowestWinningTotal << " wins." << endl;
+    out << left << setw(nameWidth) << "Team" << right
+        << setw(ceilingWidth) << "Ceiling" << setw(13) << "Elimination" << setw(8) << "Magic" << endl;
+    for (int team = 0; team < division.getNumTeams(); ++team) {
+        const TeamNumbers& n = numbers.teams[team];
+        out << left << setw(nameWidth) << names[team] << right << setw(ceilingWidth) << n.ceiling;
+        if (n.eliminationNumber < 0) {
+            out << setw(13) << "eliminated" << setw(8) << "-" << endl;
+        } else {
+            out << setw(13) << n.eliminationNumber << setw(8) << n.magicNumber << endl;
+        }
+    }
+}
+
+// -----------------------------
+// Results Stream
+// -----------------------------
+// Reads "Winner Loser" lines (team names) after the initial standings have
+// been loaded and prints only the teams whose status changed, flushing once
+// per result. Blank lines and lines starting with '#' are ignored; a bad
+// line is reported on stderr and skipped.
+void writeStatusChange(const Division& division, int teamIndex, const TeamStatus& status, ostream& out) {
+    string text;
+    appendStatusText(text, division, teamIndex, status);
+    out << text;
+}
+
+void runResultsStream(const Division& division, SolverKind solverKind, NetworkModel model, istream& in, ostream& out) {
+    LeagueTracker tracker(division, solverKind, model);
+    string line;
+    int lineNumber = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        istringstream ss(line);
+        string winner, loser, extra;
+        if (!(ss >> winner) || winner[0] == '#') continue;
+
+        try {
+            if (!(ss >> loser) || (ss >> extra)) {
+                throw runtime_error("Error: Expected 'Winner Loser'.");
+            }
+            const Division& live = tracker.getDivision();
+            int winnerIndex = live.getTeamIndex(winner);
+            int loserIndex = live.getTeamIndex(loser);
+            for (int teamIndex : tracker.recordResult(winnerIndex, loserIndex)) {
+                writeStatusChange(live, teamIndex, tracker.getStatus(teamIndex), out);
+            }
+            out.flush();
+        } catch (const runtime_error& e) {
+            cerr << "Line " << lineNumber << ": " << e.what() << endl;
+        }
+    }
+}
+
+// -----------------------------
+// Batch Mode
+// -----------------------------
+// Analyzes many divisions in one process as a three-stage pipeline: a
+// parser thread reads the next division while the current one is solved,
+// and a writer thread prints finished reports in input order. A text file
+// may hold several divisions back to back; a binary file holds one.
+
+// Bounded FIFO between two pipeline stages. After close() the consumer
+// drains what is left and then pop() returns false.
+template <typename T>
+class Channel {
+private:
+    mutex lock;
+    condition_variable changed;
+    deque<T> items;
+    size_t capacity;
+    bool closed = false;
+
+public:
+    explicit Channel(size_t cap) : capacity(cap) {}
+
+    void push(T item) {
+        unique_lock<mutex> guard(lock);
+        changed.wait(guard, [&] { return items.size() < capacity; });
+        items.push_back(move(item));
+        changed.notify_all();
+    }
+
+    bool pop(T& item) {
+        unique_lock<mutex> guard(lock);
+        changed.wait(guard, [&] { return !items.empty() || closed; });
+        if (items.empty()) {
+            return false;
+        }
+        item = move(items.front());
+        items.pop_front();
+        changed.notify_all();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        changed.notify_all();
+    }
+};
+
+struct BatchItem {
+    string label;                   // file name, plus the division number in multi-division files
+    unique_ptr<Division> division;  // null when the input could not be read
+    vector<TeamStatus> statuses;
+    string error;
+};
+
+// Parses every division of every file into `parsed`. A bad file is reported
+// through its item and skips the rest of that file only.
+void parseBatchFiles(const vector<string>& filenames, Channel<BatchItem>& parsed) {
+    for (const string& filename : filenames) {
+        int divisionsRead = 0;
+        try {
+            if (Division::isBinaryFile(filename)) {
+                parsed.push({filename, make_unique<Division>(filename), {}, ""});
+                continue;
+            }
+            MappedFile file(filename);
+            StandingsParser parser(file.begin(), file.end());
+            while (parser.skipBlankLines()) {
+                string label = filename + " #" + to_string(divisionsRead + 1);
+                parsed.push({label, make_unique<Division>(parser), {}, ""});
+                divisionsRead++;
+            }
+            if (divisionsRead == 0) {
+                throw runtime_error("Error: The input file is empty.");
+            }
+        } catch (const exception& e) {
+            string label = filename + (divisionsRead > 0 ? " #" + to_string(divisionsRead + 1) : "");
+            parsed.push({label, nullptr, {}, e.what()});
+        }
+    }
+    parsed.close();
+}
+
+// Returns false if any division could not be read.
+bool runBatch(const vector<string>& filenames, SolverKind solverKind, NetworkModel model, int numThreads,
+              OutputFormat format, ostream& out, ostream& err) {
+    Channel<BatchItem> parsed(2);
+    Channel<BatchItem> solved(2);
+    bool allRead = true;
+
+    thread parser(parseBatchFiles, cref(filenames), ref(parsed));
+    thread writer([&] {
+        ReportWriter report(out, format, true);
+        for (BatchItem item; solved.pop(item);) {
+            if (!item.error.empty()) {
+                err << item.label << ": " << item.error << "\n";
+                allRead = false;
+                continue;
+            }
+            report.beginDivision(item.label);
+            report.writeDivision(*item.division, item.statuses);
+        }
+        report.finish();
+        err.flush();
+    });
+
+    for (BatchItem item; parsed.pop(item);) {
+        if (item.division) {
+            item.statuses = analyzeDivision(*item.division, solverKind, model, numThreads);
+        }
+        solved.push(move(item));
+    }
+    solved.close();
+
+    parser.join();
+    writer.join();
+    return allRead;
+}
+
+// -----------------------------
+// Query Server
+// -----------------------------
+// --serve keeps every division's LeagueTracker, and with it the solved flow
+// networks, resident and answers line-based requests on a Unix socket:
+//   USE <file>                 switch this connection to another loaded division
+//   STATUS <team>              one team's status
+//   TABLE                      every team's status
+//   RESULT <winner> <loser>    record a result, reply with the changed teams
+//   LATENCY                    request latency percentiles
+//   QUIT
+// Statuses use the stream-mode wording. Every reply ends with a line holding
+// a single "."; a failed request replies "ERROR <message>" instead.
+
+// Latencies of the most recent requests, in microseconds.
+class LatencyRecorder {
+private:
+    static constexpr size_t window = 8192;
+    mutex lock;
+    vector<double> samples;
+    size_t next = 0;
+    long long total = 0;
+
+public:
+    void record(double micros) {
+        lock_guard<mutex> guard(lock);
+        if (samples.size() < window) {
+            samples.push_back(micros);
+        } else {
+            samples[next] = micros;
+        }
+        next = (next + 1) % window;
+        total++;
+    }
+
+    void write(ostream& out) {
+        vector<double> sorted;
+        long long count;
+        {
+            lock_guard<mutex> guard(lock);
+            sorted = samples;
+            count = total;
+        }
+        sort(sorted.begin(), sorted.end());
+        auto percentile = [&](double p) {
+            return sorted.empty() ? 0.0 : sorted[min(sorted.size() - 1, size_t(p * sorted.size()))];
+        };
+        out << fixed << setprecision(1);
+        out << "requests " << count << "\n";
+        out << "window " << sorted.size() << "\n";
+        out << "p50_us " << percentile(0.50) << "\n";
+        out << "p90_us " << percentile(0.90) << "\n";
+        out << "p99_us " << percentile(0.99) << "\n";
+        out << "max_us " << (sorted.empty() ? 0.0 : sorted.back()) << "\n";
+    }
+};
+
+class QueryServer {
+private:
+    // A connection whose unterminated request grows past maxRequestLength
+    // gets an error and is closed. At most maxClients connections are served
+    // at once; further ones wait in the listen backlog until a slot frees.
+    static constexpr size_t maxRequestLength = 4096;
+    static constexpr int maxClients = 64;
+
+    struct LoadedDivision {
+        string name;
+        LeagueTracker tracker;
+        mutex lock;
+
+        LoadedDivision(const string& filename, SolverKind kind, NetworkModel model)
+            : name(filename), tracker(Division(filename), kind, model) {}
+    };
+
+    vector<unique_ptr<LoadedDivision>> divisions;
+    LatencyRecorder latency;
+    mutex clientsLock;
+    condition_variable clientFinished;
+    int activeClients = 0;
+
+    // Answers one request; `current` is the connection's division.
+    string handle(const string& line, int& current, bool& quit) {
+        istringstream in(line);
+        string command, first, second, extra;
+        in >> command >> first >> second >> extra;
+        ostringstream out;
+
+        if (command == "QUIT") {
+            quit = true;
+        } else if (command == "LATENCY") {
+            latency.write(out);
+        } else if (command == "USE" && !first.empty()) {
+            auto it = find_if(divisions.begin(), divisions.end(), [&](const auto& d) { return d->name == first; });
+            if (it == divisions.end()) {
+                throw runtime_error("Error: No division loaded from '" + first + "'.");
+            }
+            current = it - divisions.begin();
+        } else if ((command == "STATUS" && !first.empty() && second.empty()) || (command == "TABLE" && first.empty())) {
+            LoadedDivision& loaded = *divisions[current];
+            lock_guard<mutex> guard(loaded.lock);
+            const Division& division = loaded.tracker.getDivision();
+            if (command == "STATUS") {
+                int team = division.getTeamIndex(first);
+                writeStatusChange(division, team, loaded.tracker.getStatus(team), out);
             } else {
-                // Non-trivial elimination check using Flow Network
-                FlowNetwork fn(division, teamIndex);
-                if (fn.isEliminated()) {
-                    vector<string> certificate = fn.getEliminationCertificate();
-                    cout << division.getTeamNames()[teamIndex] << " is eliminated." << endl;
-                    cout << "They are eliminated by the subset { ";
-                    for (const auto& team : certificate) {
-                        cout << team << " ";
+                for (int team = 0; team < division.getNumTeams(); ++team) {
+                    writeStatusChange(division, team, loaded.tracker.getStatus(team), out);
+                }
+            }
+        } else if (command == "RESULT" && !second.empty() && extra.empty()) {
+            LoadedDivision& loaded = *divisions[current];
+            lock_guard<mutex> guard(loaded.lock);
+            const Division& division = loaded.tracker.getDivision();
+            int winner = division.getTeamIndex(first);
+            int loser = division.getTeamIndex(second);
+            for (int team : loaded.tracker.recordResult(winner, loser)) {
+                writeStatusChange(division, team, loaded.tracker.getStatus(team), out);
+            }
+        } else {
+            throw runtime_error("Error: Unknown request '" + line + "'.");
+        }
+
+        out << ".\n";
+        return out.str();
+    }
+
+    static bool sendAll(int fd, const string& data) {
+        for (size_t sent = 0; sent < data.size();) {
+            ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return false;
+            }
+            sent += n;
+        }
+        return true;
+    }
+
+    void serveClient(int fd) {
+        int current = 0;
+        bool quit = false;
+        string pending;
+        char buffer[4096];
+        while (!quit) {
+            ssize_t n = recv(fd, buffer, sizeof buffer, 0);
+            if (n <= 0) break;
+            pending.append(buffer, n);
+
+            size_t lineEnd;
+            while (!quit && (lineEnd = pending.find('\n')) != string::npos) {
+                string line = pending.substr(0, lineEnd);
+                pending.erase(0, lineEnd + 1);
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (line.empty()) continue;
+
+                auto start = chrono::steady_clock::now();
+                string reply;
+                try {
+                    reply = handle(line, current, quit);
+                } catch (const exception& e) {
+                    string message = e.what();
+                    if (message.rfind("Error: ", 0) == 0) message.erase(0, 7);
+                    reply = "ERROR " + message + "\n";
+                }
+                bool delivered = sendAll(fd, reply);
+                latency.record(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+                if (!delivered) {
+                    quit = true;
+                }
+            }
+            if (!quit && pending.size() > maxRequestLength) {
+                sendAll(fd, "ERROR Request line is longer than " + to_string(maxRequestLength) + " bytes.\n");
+                quit = true;
+            }
+        }
+        close(fd);
+
+        lock_guard<mutex> guard(clientsLock);
+        activeClients--;
+        clientFinished.notify_one();
+    }
+
+public:
+    // Loads and solves every division up front.
+    QueryServer(const vector<string>& filenames, SolverKind kind, NetworkModel model) {
+        for (const string& filename : filenames) {
+            divisions.push_back(make_unique<LoadedDivision>(filename, kind, model));
+        }
+    }
+
+    // Serves clients on `socketPath` until the process is stopped, one thread
+    // per connection and at most maxClients of them at a time.
+    [[noreturn]] void run(const string& socketPath) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof address.sun_path) {
+            throw runtime_error("Error: Socket path '" + socketPath + "' is too long.");
+        }
+        strcpy(address.sun_path, socketPath.c_str());
+
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) {
+            throw runtime_error("Error: Cannot create a socket.");
+        }
+        unlink(socketPath.c_str());
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof address) < 0 || listen(listener, 64) < 0) {
+            close(listener);
+            throw runtime_error("Error: Cannot listen on '" + socketPath + "'.");
+        }
+
+        while (true) {
+            {
+                unique_lock<mutex> guard(clientsLock);
+                clientFinished.wait(guard, [&] { return activeClients < maxClients; });
+            }
+            int client = accept(listener, nullptr, nullptr);
+            if (client < 0) continue;
+            {
+                lock_guard<mutex> guard(clientsLock);
+                activeClients++;
+            }
+            thread(&QueryServer::serveClient, this, client).detach();
+        }
+    }
+};
+
+// -----------------------------
+// League Generator
+// -----------------------------
+// Writes a valid text Division with a symmetric schedule. Each pair's games
+// come from a hash of (seed, pair), so rows are produced one at a time and a
+// 10k-team league never needs the full matrix in memory.
+struct LeagueSpec {
+    int numTeams = 30;
+    double density = 0.5;           // chance that a pair still has fixtures left
+    int maxGamesPerPair = 3;
+    int winSpread = -1;             // range of current wins; -1 means numTeams
+    uint64_t seed = 1;
+};
+
+uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+int generatedGames(const LeagueSpec& spec, int i, int j) {
+    if (i == j) return 0;
+    if (i > j) swap(i, j);
+    uint64_t h = splitMix64(spec.seed ^ splitMix64((uint64_t(i) << 32) | uint32_t(j)));
+    double draw = (h >> 11) * (1.0 / 9007199254740992.0);
+    if (draw >= spec.density) return 0;
+    return 1 + int(splitMix64(h) % spec.maxGamesPerPair);
+}
+
+void generateLeague(const LeagueSpec& spec, ostream& out) {
+    if (spec.numTeams < 2 || spec.density < 0 || spec.density > 1 || spec.maxGamesPerPair < 1) {
+        throw runtime_error("Error: Invalid league generator settings.");
+    }
+    int spread = spec.winSpread < 0 ? spec.numTeams : spec.winSpread;
+    mt19937_64 rng(spec.seed);
+    uniform_int_distribution<int> offset(0, spread);
+    int base = 2 * spec.maxGamesPerPair * spec.numTeams;
+
+    vector<int> row(spec.numTeams);
+    out << spec.numTeams << "\n";
+    for (int i = 0; i < spec.numTeams; ++i) {
+        long long remaining = 0;
+        for (int j = 0; j < spec.numTeams; ++j) {
+            row[j] = generatedGames(spec, i, j);
+            remaining += row[j];
+        }
+        out << "Team" << i << " " << base + offset(rng) << " " << base + offset(rng) << " " << remaining << " ";
+        for (int j = 0; j < spec.numTeams; ++j) {
+            out << " " << row[j];
+        }
+        out << "\n";
+    }
+}
+
+// -----------------------------
+// Monte Carlo Simulation
+// -----------------------------
+// Estimates every team's chance of finishing first by playing out the
+// remaining fixtures at random. A game between i and j goes to i with
+// probability s_i / (s_i + s_j) for the team strengths s (all equal by
+// default). A tie for first gives each leader an equal share.
+//
+// Teams the exact check eliminates can never lead: in every outcome some
+// team finishes ahead of them, so the leader is always a contender. Only
+// the contenders' totals are tracked, and games between two eliminated
+// teams are never drawn. Samples are processed in blocks of 64, laid out
+// team-major so that the max, tie-count and credit passes are plain loops
+// over one block that the compiler vectorizes. Tallies are 32-bit counts of
+// wins above the fewest any contender has, which keeps the lanes narrow for
+// 64-bit standings. Every block has its own splitmix stream seeded from
+// (seed, block), so the estimate does not depend on how many threads run or
+// which thread takes which block.
+struct SimulationSpec {
+    long long samples = 1000000;
+    uint64_t seed = 1;
+    int numThreads = 1;
+    vector<double> strengths;       // per team; empty means every game is a coin flip
+};
+
+struct SimulationResult {
+    long long samples = 0;
+    vector<bool> eliminated;        // per team, from the exact check
+    vector<double> firstPlace;      // per team, probability of finishing first
+};
+
+// Reads "Team strength" lines; teams that are not listed keep strength 1.
+vector<double> readStrengths(const Division& division, const string& filename) {
+    ifstream in(filename);
+    if (!in) {
+        throw runtime_error("Error: File '" + filename + "' does not exist.");
+    }
+    vector<double> strengths(division.getNumTeams(), 1.0);
+    string name;
+    double strength;
+    while (in >> name >> strength) {
+        if (!(strength > 0)) {
+            throw runtime_error("Error: Strength of " + name + " must be positive.");
+        }
+        strengths[division.getTeamIndex(name)] = strength;
+    }
+    if (!in.eof()) {
+        throw runtime_error("Error: Expected 'Team strength' lines in '" + filename + "'.");
+    }
+    return strengths;
+}
+
+SimulationResult simulateFirstPlace(const Division& division, const SimulationSpec& spec,
+                                    SolverKind solverKind, NetworkModel model) {
+    constexpr int block = 64;
+    int numTeams = division.getNumTeams();
+    SimulationResult result;
+    result.samples = spec.samples;
+    result.eliminated = findEliminationThreshold(division, solverKind, model).eliminated;
+    result.firstPlace.assign(numTeams, 0.0);
+
+    vector<int> contenders;
+    vector<int> slotOf(numTeams, -1);
+    for (int team = 0; team < numTeams; ++team) {
+        if (!result.eliminated[team]) {
+            slotOf[team] = contenders.size();
+            contenders.push_back(team);
+        }
+    }
+    int numSlots = contenders.size();
+
+    long long baseWins = LLONG_MAX, highestCeiling = 0;
+    for (int team : contenders) {
+        baseWins = min(baseWins, division.getWins()[team]);
+        highestCeiling = max(highestCeiling, division.getWins()[team] + division.getRemainingGames()[team]);
+    }
+    if (highestCeiling - baseWins > INT_MAX) {
+        throw runtime_error("Error: The contenders' standings are too far apart to simulate.");
+    }
+
+    // Fixtures that touch a contender, with slot -1 for an eliminated side
+    struct SimulatedFixture {
+        int slotI;
+        int slotJ;
+        int games;
+        uint64_t winThreshold;      // a draw below this goes to i
+    };
+    vector<SimulatedFixture> fixtures;
+    const Schedule& schedule = division.getSchedule();
+    for (int i = 0; i < numTeams; ++i) {
+        for (int e = schedule.upperEntryBegin(i); e < schedule.entryEnd(i); ++e) {
+            int j = schedule.opponentAt(e);
+            if (schedule.gamesAt(e) == 0 || (slotOf[i] < 0 && slotOf[j] < 0)) continue;
+            double p = 0.5;
+            if (!spec.strengths.empty()) {
+                p = spec.strengths[i] / (spec.strengths[i] + spec.strengths[j]);
+            }
+            // p rounds to 1 when s_j / s_i < 2^-53, and 2^64 does not fit
+            uint64_t winThreshold = p < 1 ? uint64_t(p * 18446744073709551616.0) : UINT64_MAX;
+            fixtures.push_back({slotOf[i], slotOf[j], schedule.gamesAt(e), winThreshold});
+        }
+    }
+
+    long long numBlocks = (spec.samples + block - 1) / block;
+    int numThreads = max<long long>(1, min<long long>(spec.numThreads, numBlocks));
+    vector<vector<double>> shares(numThreads, vector<double>(numSlots, 0.0));
+    atomic<long long> nextBlock(0);
+
+    auto worker = [&](int threadIndex) {
+        vector<double>& share = shares[threadIndex];
+        vector<int> tally(size_t(numSlots) * block);
+        int best[block];
+        int leaders[block];
+        double credit[block];
+
+        for (long long b = nextBlock++; b < numBlocks; b = nextBlock++) {
+            int valid = min<long long>(block, spec.samples - b * block);
+            uint64_t state = splitMix64(spec.seed ^ splitMix64(b));
+
+            for (int c = 0; c < numSlots; ++c) {
+                fill(tally.begin() + c * block, tally.begin() + (c + 1) * block, int(division.getWins()[contenders[c]] - baseWins));
+            }
+            for (const auto& f : fixtures) {
+                int* winsI = f.slotI >= 0 ? &tally[f.slotI * block] : nullptr;
+                int* winsJ = f.slotJ >= 0 ? &tally[f.slotJ * block] : nullptr;
+                for (int s = 0; s < block; ++s) {
+                    int wonByI = 0;
+                    for (int g = 0; g < f.games; ++g) {
+                        state += 0x9E3779B97F4A7C15ULL;
+                        wonByI += splitMix64(state) < f.winThreshold;
+                    }
+                    if (winsI) winsI[s] += wonByI;
+                    if (winsJ) winsJ[s] += f.games - wonByI;
+                }
+            }
+
+            for (int s = 0; s < block; ++s) {
+                best[s] = INT_MIN;
+                leaders[s] = 0;
+            }
+            for (int c = 0; c < numSlots; ++c) {
+                const int* wins = &tally[c * block];
+                for (int s = 0; s < block; ++s) {
+                    best[s] = max(best[s], wins[s]);
+                }
+            }
+            for (int c = 0; c < numSlots; ++c) {
+                const int* wins = &tally[c * block];
+                for (int s = 0; s < block; ++s) {
+                    leaders[s] += wins[s] == best[s];
+                }
+            }
+            for (int s = 0; s < block; ++s) {
+                credit[s] = s < valid ? 1.0 / leaders[s] : 0.0;
+            }
+            for (int c = 0; c < numSlots; ++c) {
+                const int* wins = &tally[c * block];
+                double sum = 0;
+                for (int s = 0; s < block; ++s) {
+                    sum += wins[s] == best[s] ? credit[s] : 0.0;
+                }
+                share[c] += sum;
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < numThreads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    for (int c = 0; c < numSlots; ++c) {
+        double total = 0;
+        for (const auto& share : shares) {
+            total += share[c];
+        }
+        result.firstPlace[contenders[c]] = spec.samples > 0 ? total / spec.samples : 0.0;
+    }
+    return result;
+}
+
+void writeSimulation(const Division& division, const SimulationResult& result, ostream& out) {
+    const auto& names = division.getTeamNames();
+    size_t nameWidth = 4;
+    for (const auto& name : names) {
+        nameWidth = max(nameWidth, name.size());
+    }
+    int skipped = count(result.eliminated.begin(), result.eliminated.end(), true);
+    out << "Simulated " << result.samples << " seasons; " << skipped << " eliminated teams skipped." << endl;
+    out << left << setw(nameWidth + 2) << "Team" << right << setw(10) << "First" << endl;
+    for (int team = 0; team < division.getNumTeams(); ++team) {
+        out << left << setw(nameWidth + 2) << names[team] << right << setw(10);
+        if (result.eliminated[team]) {
+            out << "eliminated" << endl;
+        } else {
+            out << fixed << setprecision(2) << 100 * result.firstPlace[team] << "%" << endl;
+        }
+    }
+}
+
+// -----------------------------
+// Benchmark
+// -----------------------------
+// For each league size, generates a league into a temporary file and times
+// parsing once, then network construction, max flow and certificate
+// extraction for each engine and network model (or just --solver and
+// --model) over a sample of teams.
+struct BenchmarkRow {
+    int numTeams = 0;
+    SolverKind solverKind = SolverKind::EdmondsKarp;
+    NetworkModel model = NetworkModel::Pairs;
+    double parseMs = 0;
+    double buildMs = 0;
+    double flowMs = 0;
+    double certificateMs = 0;
+    int teamsAnalyzed = 0;
+};
+
+const char* solverName(SolverKind kind) {
+    switch (kind) {
+        case SolverKind::Dinic: return "dinic";
+        case SolverKind::PushRelabel: return "push-relabel";
+        case SolverKind::EdmondsKarp:
+        default: return "ek";
+    }
+}
+
+const char* modelName(NetworkModel model) {
+    switch (model) {
+        case NetworkModel::Teams: return "teams";
+        case NetworkModel::Implicit: return "implicit";
+        case NetworkModel::Pairs:
+        default: return "pairs";
+    }
+}
+
+vector<BenchmarkRow> runBenchmark(const vector<int>& sizes, const vector<SolverKind>& solvers, const vector<NetworkModel>& models,
+                                  LeagueSpec spec, int maxTeamsPerSize) {
+    vector<BenchmarkRow> rows;
+    for (int size : sizes) {
+        spec.numTeams = size;
+        char path[] = "/tmp/sixthsense-bench-XXXXXX";
+        int fd = mkstemp(path);
+        if (fd < 0) {
+            throw runtime_error("Error: Cannot create a temporary benchmark file.");
+        }
+        close(fd);
+        {
+            ofstream out(path);
+            generateLeague(spec, out);
+        }
+
+        auto start = chrono::steady_clock::now();
+        Division division(path);
+        double parseMs = millisecondsSince(start);
+        unlink(path);
+
+        int step = max(1, size / maxTeamsPerSize);
+        for (SolverKind kind : solvers) {
+            for (NetworkModel model : models) {
+                // The implicit network has its own engine, so it gets one row
+                if (model == NetworkModel::Implicit && kind != solvers.front()) continue;
+                BenchmarkRow row;
+                row.numTeams = size;
+                row.solverKind = kind;
+                row.model = model;
+                row.parseMs = parseMs;
+                auto timeTeam = [&](auto build) {
+                    start = chrono::steady_clock::now();
+                    auto fn = build();
+                    row.buildMs += millisecondsSince(start);
+
+                    start = chrono::steady_clock::now();
+                    fn.solve();
+                    row.flowMs += millisecondsSince(start);
+
+                    start = chrono::steady_clock::now();
+                    fn.analyze();
+                    row.certificateMs += millisecondsSince(start);
+                    row.teamsAnalyzed++;
+                };
+                withCapacityType(division, [&](auto cap) {
+                    using Cap = decltype(cap);
+                    NetworkArena<Cap> arena;
+                    for (int teamIndex = 0; teamIndex < size; teamIndex += step) {
+                        if (model == NetworkModel::Implicit) {
+                            timeTeam([&] { return ImplicitFlowNetwork<Cap>(division, teamIndex, &arena); });
+                        } else {
+                            timeTeam([&] { return FlowNetwork<Cap>(division, teamIndex, kind, model, &arena); });
+                        }
+                    }
+                });
+                rows.push_back(row);
+            }
+        }
+    }
+    return rows;
+}
+
+void writeBenchmark(const vector<BenchmarkRow>& rows, ostream& out) {
+    out << setw(7) << "teams" << setw(14) << "solver" << setw(9) << "model" << setw(11) << "parse_ms" << setw(11) << "build_ms"
+        << setw(11) << "flow_ms" << setw(11) << "cert_ms" << setw(9) << "sampled" << setw(12) << "teams/s" << endl;
+    out << fixed << setprecision(2);
+    for (const auto& row : rows) {
+        double solveMs = row.buildMs + row.flowMs + row.certificateMs;
+        double throughput = solveMs > 0 ? row.teamsAnalyzed * 1000.0 / solveMs : 0;
+        const char* solver = row.model == NetworkModel::Implicit ? "-" : solverName(row.solverKind);
+        out << setw(7) << row.numTeams << setw(14) << solver << setw(9) << modelName(row.model) << setw(11) << row.parseMs
+            << setw(11) << row.buildMs << setw(11) << row.flowMs << setw(11) << row.certificateMs
+            << setw(9) << row.teamsAnalyzed << setw(12) << throughput << endl;
+    }
+}
+
+// -----------------------------
+// Solver Statistics
+// -----------------------------
+// One object per team plus a "total" object; the totals sum every counter,
+// keep the largest network's memory and add the wall time of the whole run.
+void writeStatsJson(const Division& division, SolverKind solverKind, NetworkModel model,
+                    const vector<TeamStats>& stats, double wallMs, ostream& out) {
+    TeamStats total;
+    int flowNetworks = 0;
+    out << fixed << setprecision(3);
+    out << "{\n  \"solver\": " << jsonString(solverName(solverKind)) << ",\n  \"model\": " << jsonString(modelName(model))
+        << ",\n  \"capacity_type\": " << jsonString(capacityTypeName(chooseCapacityType(division))) << ",\n  \"teams\": [";
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const TeamStats& t = stats[i];
+        out << (i ? ",\n" : "\n") << "    {\"team\": " << jsonString(division.getTeamNames()[i])
+            << ", \"trivial\": " << (t.trivial ? "true" : "false")
+            << ", \"prefiltered\": " << (t.prefiltered ? "true" : "false")
+            << ", \"eliminated\": " << (t.eliminated ? "true" : "false")
+            << ", \"nodes\": " << t.nodes << ", \"arcs\": " << t.arcs
+            << ", \"max_flow\": " << t.maxFlow << ", \"total_games\": " << t.totalGames
+            << ", \"build_ms\": " << t.buildMs << ", \"solve_ms\": " << t.solveMs
+            << ", \"certificate_ms\": " << t.certificateMs
+            << ", \"augmenting_paths\": " << t.counters.augmentingPaths << ", \"phases\": " << t.counters.phases
+            << ", \"pushes\": " << t.counters.pushes << ", \"relabels\": " << t.counters.relabels
+            << ", \"arc_scans\": " << t.counters.arcScans
+            << ", \"residual_bytes\": " << t.residualBytes << ", \"allocations\": " << t.allocations << "}";
+
+        if (!t.trivial && !t.prefiltered) flowNetworks++;
+        total.buildMs += t.buildMs;
+        total.solveMs += t.solveMs;
+        total.certificateMs += t.certificateMs;
+        total.counters.augmentingPaths += t.counters.augmentingPaths;
+        total.counters.phases += t.counters.phases;
+        total.counters.pushes += t.counters.pushes;
+        total.counters.relabels += t.counters.relabels;
+        total.counters.arcScans += t.counters.arcScans;
+        total.residualBytes = max(total.residualBytes, t.residualBytes);
+        total.allocations += t.allocations;
+    }
+    out << "\n  ],\n  \"total\": {\"teams\": " << stats.size() << ", \"flow_networks\": " << flowNetworks
+        << ", \"wall_ms\": " << wallMs
+        << ", \"build_ms\": " << total.buildMs << ", \"solve_ms\": " << total.solveMs
+        << ", \"certificate_ms\": " << total.certificateMs
+        << ", \"augmenting_paths\": " << total.counters.augmentingPaths << ", \"phases\": " << total.counters.phases
+        << ", \"pushes\": " << total.counters.pushes << ", \"relabels\": " << total.counters.relabels
+        << ", \"arc_scans\": " << total.counters.arcScans
+        << ", \"peak_residual_bytes\": " << total.residualBytes << ", \"allocations\": " << total.allocations << "}\n}\n";
+}
+
+// -----------------------------
+// Main Function
+// -----------------------------
+// Usage: wow [--solver ek|dinic|push-relabel] [--model pairs|teams|implicit] [--threads N] [--stats json]
+//            [--format text|jsonl|csv] [file]
+//        wow [--solver ...] --stream file < results
+//        wow [--solver ...] --threshold [file]
+//        wow [--solver ...] --numbers [file]
+//        wow --convert input output     (text <-> binary division)
+//        wow --generate N [--density D] [--games-per-pair G] [--spread S] [--seed K] [output]
+//        wow [--solver ...] --bench [N,N,...] [--sample K] [--density D] [--seed K]
+//        wow [--solver ...] [--threads N] [--format ...] --batch file...
+//        wow [--solver ...] --serve socket file...
+//        wow [--threads N] --simulate N [--strengths file] [--seed K] [file]
+// Without a file argument the name is read from standard input. In stream
+// mode the standings come from the file and results are read from stdin.
+int main(int argc, char* argv[]) {
+    try {
+        SolverKind solverKind = SolverKind::EdmondsKarp;
+        bool solverChosen = false;
+        NetworkModel model = NetworkModel::Pairs;
+        bool modelChosen = false;
+        OutputFormat outputFormat = OutputFormat::Text;
+        int numThreads = 1;
+        bool streamResults = false;
+        bool thresholdOnly = false;
+        bool eliminationNumbers = false;
+        string convertOutput;
+        bool generate = false;
+        vector<int> benchSizes;
+        int benchSample = 64;
+        LeagueSpec spec;
+        bool batch = false;
+        string socketPath;
+        string statsPath;
+        long long simulateSamples = 0;
+        string strengthsPath;
+        vector<string> inputFiles;
+        string filename;
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--solver" && i + 1 < argc) {
+                solverKind = parseSolverKind(argv[++i]);
+                solverChosen = true;
+            } else if (arg == "--model" && i + 1 < argc) {
+                model = parseNetworkModel(argv[++i]);
+                modelChosen = true;
+            } else if (arg == "--format" && i + 1 < argc) {
+                outputFormat = parseOutputFormat(argv[++i]);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                numThreads = stoi(argv[++i]);
+                if (numThreads < 1) {
+                    numThreads = max(1u, thread::hardware_concurrency());
+                }
+            } else if (arg == "--stream") {
+                streamResults = true;
+            } else if (arg == "--threshold") {
+                thresholdOnly = true;
+            } else if (arg == "--numbers") {
+                eliminationNumbers = true;
+            } else if (arg == "--generate" && i + 1 < argc) {
+                generate = true;
+                spec.numTeams = stoi(argv[++i]);
+            } else if (arg == "--density" && i + 1 < argc) {
+                spec.density = stod(argv[++i]);
+            } else if (arg == "--games-per-pair" && i + 1 < argc) {
+                spec.maxGamesPerPair = stoi(argv[++i]);
+            } else if (arg == "--spread" && i + 1 < argc) {
+                spec.winSpread = stoi(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                spec.seed = stoull(argv[++i]);
+            } else if (arg == "--bench") {
+                benchSizes = {10, 30, 100};
+                if (i + 1 < argc && isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                    benchSizes.clear();
+                    istringstream sizes(argv[++i]);
+                    for (string size; getline(sizes, size, ',');) {
+                        benchSizes.push_back(stoi(size));
                     }
-                    cout << "}." << endl;
-                    cout << endl;
-                } else {
-                    cout << division.getTeamNames()[teamIndex] << " is not eliminated." << endl;
-                    cout << endl;
                 }
+            } else if (arg == "--sample" && i + 1 < argc) {
+                benchSample = max(1, stoi(argv[++i]));
+            } else if (arg == "--convert" && i + 2 < argc) {
+                filename = argv[++i];
+                convertOutput = argv[++i];
+            } else if (arg == "--simulate" && i + 1 < argc) {
+                simulateSamples = stoll(argv[++i]);
+                if (simulateSamples < 1) {
+                    throw runtime_error("Error: --simulate needs a positive number of samples.");
+                }
+            } else if (arg == "--strengths" && i + 1 < argc) {
+                strengthsPath = argv[++i];
+            } else if (arg == "--stats" && i + 1 < argc) {
+                statsPath = argv[++i];
+            } else if (arg == "--batch") {
+                batch = true;
+            } else if (arg == "--serve" && i + 1 < argc) {
+                socketPath = argv[++i];
+            } else {
+                filename = arg;
+                inputFiles.push_back(arg);
+            }
+        }
+
+        // Warm repairs and ceiling changes need a built network
+        if (model == NetworkModel::Implicit && (streamResults || thresholdOnly || eliminationNumbers ||
+                                                simulateSamples > 0 || !socketPath.empty())) {
+            throw runtime_error("Error: --model implicit only supports the per-team report, --batch and --bench.");
+        }
+
+        if (generate) {
+            if (filename.empty()) {
+                generateLeague(spec, cout);
+            } else {
+                ofstream out(filename);
+                generateLeague(spec, out);
+            }
+            return 0;
+        }
+
+        if (!benchSizes.empty()) {
+            vector<SolverKind> solvers = {SolverKind::EdmondsKarp, SolverKind::Dinic, SolverKind::PushRelabel};
+            if (solverChosen) {
+                solvers = {solverKind};
+            }
+            vector<NetworkModel> models = {NetworkModel::Pairs, NetworkModel::Teams, NetworkModel::Implicit};
+            if (modelChosen) {
+                models = {model};
+            }
+            writeBenchmark(runBenchmark(benchSizes, solvers, models, spec, benchSample), cout);
+            return 0;
+        }
+
+        // Text input becomes binary and binary input becomes text
+        if (!convertOutput.empty()) {
+            Division division(filename);
+            if (Division::isBinaryFile(filename)) {
+                ofstream out(convertOutput);
+                division.writeText(out);
+            } else {
+                division.writeBinary(convertOutput);
+            }
+            return 0;
+        }
+
+        if (!socketPath.empty()) {
+            if (inputFiles.empty()) {
+                throw runtime_error("Error: --serve needs at least one standings file.");
+            }
+            QueryServer(inputFiles, solverKind, model).run(socketPath);
+        }
+
+        if (batch) {
+            if (inputFiles.empty()) {
+                throw runtime_error("Error: --batch needs at least one input file.");
+            }
+            return runBatch(inputFiles, solverKind, model, numThreads, outputFormat, cout, cerr) ? 0 : 1;
+        }
+
+        if (streamResults) {
+            if (filename.empty()) {
+                throw runtime_error("Error: --stream needs the standings file as an argument.");
+            }
+            runResultsStream(Division(filename), solverKind, model, cin, cout);
+            return 0;
+        }
+
+        if (filename.empty()) {
+            cout << "Enter the input file name: ";
+            cin >> filename;
+            cout << endl;
+        }
+
+        Division division(filename);
+        if (thresholdOnly) {
+            writeThresholdReport(division, findEliminationThreshold(division, solverKind, model), cout);
+            return 0;
+        }
+        if (simulateSamples > 0) {
+            SimulationSpec simulation;
+            simulation.samples = simulateSamples;
+            simulation.seed = spec.seed;
+            simulation.numThreads = numThreads;
+            if (!strengthsPath.empty()) {
+                simulation.strengths = readStrengths(division, strengthsPath);
+            }
+            writeSimulation(division, simulateFirstPlace(division, simulation, solverKind, model), cout);
+            return 0;
+        }
+        if (eliminationNumbers) {
+            writeEliminationNumbers(division, computeEliminationNumbers(division, solverKind, model), cout);
+            return 0;
+        }
+
+        vector<TeamStats> stats;
+        auto start = chrono::steady_clock::now();
+        vector<TeamStatus> statuses = analyzeDivision(division, solverKind, model, numThreads, statsPath.empty() ? nullptr : &stats);
+        double wallMs = millisecondsSince(start);
+        ReportWriter report(cout, outputFormat);
+        report.writeDivision(division, statuses);
+        report.finish();
+        if (!statsPath.empty()) {
+            ofstream out(statsPath);
+            if (!out) {
+                throw runtime_error("Error: Cannot write file '" + statsPath + "'.");
             }
+            writeStatsJson(division, solverKind, model, stats, wallMs, out);
         }
     } catch (const exception& e) {
         cerr << e.what() << endl;